@@ -57,7 +57,7 @@ auto draw_game::init() -> sneze::result<> {
     // add the mouse listeners
     world()->add_listener<sneze::events::mouse_button_down, &draw_game::mouse_button_down>(this);
     world()->add_listener<sneze::events::mouse_button_up, &draw_game::mouse_button_up>(this);
-    world()->add_listener<sneze::events::mouse_moved, &draw_game::mouse_moved>(this);
+    world()->add_batch_listener<sneze::events::mouse_moved, &draw_game::mouse_moved>(this);
 
     // all good
     return true;
@@ -98,10 +98,13 @@ void draw_game::mouse_button_up(const sneze::events::mouse_button_up &event) {
 }
 
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-void draw_game::mouse_moved(const sneze::events::mouse_moved &event) {
+void draw_game::mouse_moved(std::span<const sneze::events::mouse_moved> events) {
+    // we get all the mouse movements of the frame at once, we only need the last position
+    const auto &last = events.back();
+
     // get all the entities that have the drawing tag and a line component
-    for(auto [entity, line]: event.world->get_tagged<drawing_tag, sneze::components::line>()) {
+    for(auto [entity, line]: last.world->get_tagged<drawing_tag, sneze::components::line>()) {
         // update the line to point to the mouse position
-        line.to = event.point;
+        line.to = last.point;
     }
 }
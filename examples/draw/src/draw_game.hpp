@@ -24,6 +24,8 @@ SOFTWARE.
 
 #pragma once
 
+#include <span>
+
 #include <sneze/sneze.hpp>
 
 // this is the main class for the game, it inherits from sneze::application
@@ -75,6 +77,6 @@ private:
     // mouse button up listener
     void mouse_button_up(const sneze::events::mouse_button_up &event);
 
-    // mouse moved listener
-    void mouse_moved(const sneze::events::mouse_moved &event);
+    // mouse moved batch listener, receives all the mouse movements of a frame
+    void mouse_moved(std::span<const sneze::events::mouse_moved> events);
 };
@@ -30,6 +30,7 @@ SOFTWARE.
 #include "../components/geometry.hpp"
 #include "../events/events.hpp"
 #include "../platform/error.hpp"
+#include "../render/manifest.hpp"
 
 #include "config.hpp"
 #include "settings.hpp"
@@ -37,6 +38,7 @@ SOFTWARE.
 namespace sneze {
 
 class render;
+struct render_driver;
 class world;
 
 /**
@@ -242,6 +244,29 @@ public:
         return world_;
     }
 
+    /**
+     * @brief Initialize SDL subsystems on first use.
+     *
+     * Only video and events are initialized at startup, unless config::subsystems says otherwise, any other subsystem
+     * should be required before using it, subsystems already initialized are skipped.
+     *
+     * @code
+     * my_game::enable_gamepad() -> result<> {
+     *   if(auto err = require_subsystems(device::subsystem::game_controller).ko()) {
+     *     logger::error("game can't use game controllers");
+     *     return error("Can't enable gamepad.", *err);
+     *   }
+     *   return true;
+     * }
+     * @endcode
+     *
+     * @param subsystems the subsystems required
+     *
+     * @return if the subsystems are initialized
+     * @see sneze::config::subsystems
+     */
+    [[maybe_unused]] [[nodiscard]] auto require_subsystems(const device::subsystems &subsystems) -> result<>;
+
     /**
      * @brief Load a BITMAP font from a given path.
      *
@@ -380,6 +405,68 @@ public:
      */
     [[maybe_unused]] void unload_sprite_sheet(const std::string &sprite_sheet_path);
 
+    /**
+     * @brief Get the index of a frame in a loaded sprite sheet.
+     *
+     * Resolving a frame name once and keeping the index avoids looking up the frame by name each time, this is useful
+     * for animations that cycle through many frames.
+     *
+     * @code
+     * my_game::init() -> result<> {
+     *   if(auto [index, err] = get_frame_index("sprites/sprites.json", "walk_01.png").ok(); !err) {
+     *     walk_first_frame_ = *index;
+     *   }
+     *   return true;
+     * }
+     * @endcode
+     *
+     * @param sprite_sheet_path the path to the sprite sheet
+     * @param frame the name of the frame
+     *
+     * @return the index of the frame or error if the sprite sheet is not loaded or the frame does not exist
+     */
+    [[maybe_unused]] [[nodiscard]] auto get_frame_index(const std::string &sprite_sheet_path, const std::string &frame)
+        -> result<std::size_t, error>;
+
+    /**
+     * @brief Preload a list of assets.
+     *
+     * All the textures needed by the assets, like fonts pages or sprite sheets textures, are decoded in parallel and
+     * only once, even if they are shared by several assets. While loading events::preload_progress events are
+     * triggered, so a loading screen could be updated.
+     *
+     * @note You should unload the assets when you don't need them anymore using the unload method.
+     *
+     * @code
+     * my_game::init() -> result<> {
+     *   const auto level = manifest{
+     *       {asset_type::font, "fonts/title.fnt"},
+     *       {asset_type::sprite_sheet, "sprites/level1.json"},
+     *   };
+     *   if(auto err = preload(level).ko()) {
+     *     logger::error("game can't load level");
+     *     return error("Can't load level.", *err);
+     *   }
+     *   return true;
+     * }
+     * @endcode
+     *
+     * @param assets the assets to load
+     *
+     * @return if all the assets were loaded successfully, if not none of them stay loaded by this call
+     * @see sneze::application::unload
+     */
+    [[maybe_unused]] [[nodiscard]] auto preload(const manifest &assets) -> result<>;
+
+    /**
+     * @brief Unload a list of assets.
+     *
+     * @param assets the assets to unload
+     *
+     * @see sneze::application::preload
+     */
+    [[maybe_unused]] void unload(const manifest &assets);
+
 private:
 
     //! Holds the team name
@@ -400,12 +487,24 @@ private:
     //! flag to indicate if the application want to close
     bool want_to_close_{false};
 
+    //! the file to dump the trace into
+    std::string trace_file_;
+
     //! event handler if the application want to close
     void app_want_closing(events::application_want_closing event) noexcept;
 
+    //! event handler to dump the trace
+    void dump_trace(const events::dump_trace &event);
+
     //! launch the application
     auto launch() -> result<>;
 
+    //! initialize the game application
+    auto init_application() -> result<>;
+
+    //! report the startup once the first frame is presented, closing the application if requested
+    void report_startup();
+
     //! read the settings from the settings file
     auto read_settings() noexcept -> result<>;
 
@@ -424,11 +523,11 @@ private:
     //! get the window size, fullscreen and monitor
     [[nodiscard]] auto get_window_settings(const config &cfg) -> std::tuple<components::size, bool, int>;
 
-    //! load the embedded fonts
-    [[nodiscard]] auto load_embedded_fonts() -> result<>;
+    //! save the render driver chosen and when it was probed
+    void save_render_driver_settings(const render_driver &driver);
 
-    //! unload the embedded fonts
-    void unload_embedded_fonts();
+    //! get how to choose the render driver
+    [[nodiscard]] auto get_render_driver_settings(const config &cfg) -> render_driver;
 };
 
 } // namespace sneze
@@ -0,0 +1,139 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__clang__)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+#include <entt/entt.hpp>
+#if defined(__clang__)
+#    pragma clang diagnostic pop
+#endif
+
+namespace sneze {
+
+/**
+ * @brief a buffer of structural changes to apply later to the world
+ *
+ * adding or removing entities and components while iterating the entities of the world is not safe, neither from
+ * systems that run in parallel, this class records those changes and the world applies all of them at the end of the
+ * systems update and at the end of the events dispatch.
+ *
+ * commands are applied in the order they were recorded, except destroying entities that is applied at the end, so any
+ * other command on an entity destroyed by the same buffer is still valid.
+ *
+ * @see sneze::world::commands
+ */
+class command_buffer {
+public:
+    /**
+     * @brief create an entity with a set of components
+     * @tparam Components the types of the components
+     * @param components the components to add to the entity
+     */
+    template<typename... Components>
+    void create(Components &&...components) {
+        commands_.emplace_back(
+            [values = std::make_tuple(std::forward<Components>(components)...)](entt::registry &registry) mutable {
+                auto entity = registry.create();
+                std::apply(
+                    [&registry, entity](auto &&...value) {
+                        (registry.emplace<std::decay_t<decltype(value)>>(entity, std::move(value)), ...);
+                    },
+                    values);
+            });
+    }
+
+    /**
+     * @brief destroy an entity
+     * @param entity the entity to destroy
+     */
+    void destroy(entt::entity entity) {
+        destroyed_.push_back(entity);
+    }
+
+    /**
+     * @brief set a component to an entity, replacing it if the entity already has it
+     * @tparam Type the type of the component
+     * @tparam Args the types of the arguments to pass to the component
+     * @param entity the entity to set the component to
+     * @param args the arguments to pass to the component
+     */
+    template<typename Type, typename... Args>
+    void emplace(entt::entity entity, Args &&...args) {
+        commands_.emplace_back([entity, value = Type{std::forward<Args>(args)...}](entt::registry &registry) mutable {
+            if(registry.valid(entity)) {
+                registry.emplace_or_replace<Type>(entity, std::move(value));
+            }
+        });
+    }
+
+    /**
+     * @brief remove components from an entity
+     * @tparam Types the types of the components to remove
+     * @param entity the entity to remove the components from
+     */
+    template<typename... Types>
+    void remove(entt::entity entity) {
+        commands_.emplace_back([entity](entt::registry &registry) {
+            if(registry.valid(entity)) {
+                registry.remove<Types...>(entity);
+            }
+        });
+    }
+
+    /**
+     * @brief check if there are commands to apply
+     * @return true if the buffer is empty
+     */
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return commands_.empty() && destroyed_.empty();
+    }
+
+    /**
+     * @brief apply all the commands, and empty the buffer
+     * @param registry the registry to apply the commands to
+     */
+    void apply(entt::registry &registry);
+
+    //! discard all the commands
+    void clear() noexcept;
+
+private:
+    //! the commands to apply
+    std::vector<std::function<void(entt::registry &)>> commands_{};
+
+    //! the entities to destroy
+    std::vector<entt::entity> destroyed_{};
+};
+
+} // namespace sneze
@@ -28,7 +28,9 @@ SOFTWARE.
 
 #include "../components/renderable.hpp"
 #include "../device/keyboard.hpp"
+#include "../device/subsystem.hpp"
 #include "../embedded/embedded.hpp"
+#include "../render/capture_format.hpp"
 
 namespace sneze {
 
@@ -55,7 +57,19 @@ namespace sneze {
  * - Clear color: black
  * - Exit key: NONE
  * - Toggle full screen key: NONE
+ * - Toggle profiler overlay key: NONE
+ * - Dump trace key: NONE
+ * - Trace file: sneze_trace.json
+ * - Capture key: NONE
+ * - Capture frames: 1
+ * - Capture format: png
+ * - Capture folder: current folder
  * - Icon: sneze icon
+ * - Coalesce input: false
+ * - Immediate input: false
+ * - Subsystems: none, only video and events
+ * - Probe render driver: false
+ * - Dynamic resolution: disabled
  *
  * @see application::configure()
  * @see application::init()
@@ -155,6 +169,138 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Set the toggle profiler overlay key, without modifier
+     *
+     * @param key The key to use to toggle the profiler overlay
+     * @return config& A reference to the config object to allow chaining
+     * @see frame_profile
+     */
+    [[maybe_unused]] [[nodiscard]] auto toggle_profiler_overlay(const keyboard::code &key) -> config {
+        toggle_profiler_overlay_ = {key};
+        return *this;
+    }
+
+    /**
+     * @brief Set the toggle profiler overlay key and modifier
+     *
+     * @param modifier The key modifier to use to toggle the profiler overlay
+     * @param key The key to use to toggle the profiler overlay
+     * @return config& A reference to the config object to allow chaining
+     * @see frame_profile
+     */
+    [[maybe_unused]] [[nodiscard]] auto toggle_profiler_overlay(const keyboard::mod &modifier,
+                                                                const keyboard::code &key) -> config {
+        toggle_profiler_overlay_ = {key, modifier};
+        return *this;
+    }
+
+    /**
+     * @brief Set the dump trace key, without modifier
+     *
+     * @param key The key to use to dump the trace
+     * @return config& A reference to the config object to allow chaining
+     * @see trace::dump
+     */
+    [[maybe_unused]] [[nodiscard]] auto dump_trace(const keyboard::code &key) -> config {
+        dump_trace_ = {key};
+        return *this;
+    }
+
+    /**
+     * @brief Set the dump trace key and modifier
+     *
+     * @param modifier The key modifier to use to dump the trace
+     * @param key The key to use to dump the trace
+     * @return config& A reference to the config object to allow chaining
+     * @see trace::dump
+     */
+    [[maybe_unused]] [[nodiscard]] auto dump_trace(const keyboard::mod &modifier, const keyboard::code &key)
+        -> config {
+        dump_trace_ = {key, modifier};
+        return *this;
+    }
+
+    /**
+     * @brief Set the capture key, without modifier
+     *
+     * Each time the key is pressed the next frames are captured into image files.
+     *
+     * @param key The key to use to capture frames
+     * @return config& A reference to the config object to allow chaining
+     * @see capture_frames
+     */
+    [[maybe_unused]] [[nodiscard]] auto capture(const keyboard::code &key) -> config {
+        capture_ = {key};
+        return *this;
+    }
+
+    /**
+     * @brief Set the capture key and modifier
+     *
+     * Each time the key is pressed the next frames are captured into image files.
+     *
+     * @param modifier The key modifier to use to capture frames
+     * @param key The key to use to capture frames
+     * @return config& A reference to the config object to allow chaining
+     * @see capture_frames
+     */
+    [[maybe_unused]] [[nodiscard]] auto capture(const keyboard::mod &modifier, const keyboard::code &key) -> config {
+        capture_ = {key, modifier};
+        return *this;
+    }
+
+    /**
+     * @brief Set the frames captured each time
+     *
+     * One frame takes a screenshot, more frames take a sequence of consecutive frames. The frames are written on a
+     * background thread, frames that can't be queued are dropped instead of stalling the game.
+     *
+     * @param frames The number of frames to capture
+     * @return config& A reference to the config object to allow chaining
+     */
+    [[maybe_unused]] [[nodiscard]] auto capture_frames(std::size_t frames) -> config {
+        capture_frames_ = frames;
+        return *this;
+    }
+
+    /**
+     * @brief Set the image format of the captured frames
+     *
+     * @param format The image format
+     * @return config& A reference to the config object to allow chaining
+     */
+    [[maybe_unused]] [[nodiscard]] auto capture_format(sneze::capture_format format) -> config {
+        capture_format_ = format;
+        return *this;
+    }
+
+    /**
+     * @brief Set the folder to write the captured frames into
+     *
+     * @param folder The path of the folder
+     * @return config& A reference to the config object to allow chaining
+     */
+    [[maybe_unused]] [[nodiscard]] auto capture_folder(const std::string &folder) -> config {
+        capture_folder_ = folder;
+        return *this;
+    }
+
+    /**
+     * @brief Set the file to dump the trace into
+     *
+     * The trace is dumped when the dump trace key is pressed and when the application ends, only if sneze is built
+     * with the CMake option SNEZE_ENABLE_TRACE.
+     *
+     * @param file The path of the file
+     * @return config& A reference to the config object to allow chaining
+     * @see trace::dump
+     */
+    [[maybe_unused]] [[nodiscard]] auto trace_file(const std::string &file) -> config {
+        trace_file_ = file;
+        return *this;
+    }
+
     /**
      * @brief Set the window size
      *
@@ -215,6 +361,87 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Set if the input events are coalesced
+     *
+     * When the input is coalesced, all the mouse movements of a frame are sent as a single events::mouse_moved with
+     * the last position and the accumulated movement, and only the last window resize of a frame is sent. Mouse moves
+     * are still sent before any key or mouse button event, so the order of the input is kept.
+     *
+     * @param coalesce true to coalesce the input events
+     * @return config& A reference to the config object to allow chaining
+     */
+    [[maybe_unused]] [[nodiscard]] auto coalesce_input(bool coalesce) -> config {
+        coalesce_input_ = coalesce;
+        return *this;
+    }
+
+    /**
+     * @brief Set if the input events are dispatched immediately
+     *
+     * By default the input events are queued and dispatched after all the systems are updated, so the game handles
+     * them a frame later. When the input is immediate the input events are dispatched when they are received, before
+     * the systems of the game are updated.
+     *
+     * @param immediate true to dispatch the input events immediately
+     * @return config& A reference to the config object to allow chaining
+     * @see input_latency
+     */
+    [[maybe_unused]] [[nodiscard]] auto immediate_input(bool immediate) -> config {
+        immediate_input_ = immediate;
+        return *this;
+    }
+
+    /**
+     * @brief Set the subsystems initialized at startup
+     *
+     * Only video and events are initialized by default, any other subsystem is initialized on first use with
+     * application::require_subsystems. The subsystems set here are initialized at startup instead.
+     *
+     * @code
+     * config().subsystems(device::subsystem::audio | device::subsystem::game_controller);
+     * @endcode
+     *
+     * @param subsystems The subsystems to initialize at startup
+     * @return config reference to the config
+     */
+    [[maybe_unused]] [[nodiscard]] auto subsystems(device::subsystems subsystems) -> config {
+        subsystems_ = subsystems;
+        return *this;
+    }
+
+    /**
+     * @brief Set if the render drivers are probed at startup
+     *
+     * When probing, a short synthetic batch is timed on each available render driver and the fastest one is used. The
+     * choice is saved in the render section of the settings, and it is probed again only when the SDL version or the
+     * display changes. The override setting, in the same section, forces a driver by name.
+     *
+     * @param probe If the render drivers are probed
+     * @return config reference to the config
+     */
+    [[maybe_unused]] [[nodiscard]] auto probe_render_driver(bool probe) -> config {
+        probe_render_driver_ = probe;
+        return *this;
+    }
+
+    /**
+     * @brief Enable the dynamic resolution
+     *
+     * The frames are rendered into a texture that is upscaled to the window, the resolution of the texture is lowered
+     * when the frames take longer than the target frame rate, and raised back when they take much less. The logical
+     * coordinates, and the mouse events, are the same at any resolution.
+     *
+     * @param target_fps The frames per second to keep
+     * @param min_scale The minimum scale of the resolution, between 0.1 and 1
+     * @return config reference to the config
+     */
+    [[maybe_unused]] [[nodiscard]] auto dynamic_resolution(float target_fps = 60.F, float min_scale = 0.5F) -> config {
+        dynamic_resolution_fps_ = target_fps;
+        dynamic_resolution_min_scale_ = min_scale;
+        return *this;
+    }
+
     /** @brief get the clear color
      *
      * @return the clear color
@@ -239,6 +466,62 @@ public:
         return toggle_full_screen_;
     }
 
+    /** @brief Get the toggle profiler overlay key
+     *
+     * @return const auto& The toggle profiler overlay key
+     */
+    [[nodiscard]] inline auto get_toggle_profiler_overlay_key() const -> const auto & {
+        return toggle_profiler_overlay_;
+    }
+
+    /** @brief Get the dump trace key
+     *
+     * @return const auto& The dump trace key
+     */
+    [[nodiscard]] inline auto get_dump_trace_key() const -> const auto & {
+        return dump_trace_;
+    }
+
+    /** @brief Get the capture key
+     *
+     * @return const auto& The capture key
+     */
+    [[nodiscard]] inline auto get_capture_key() const -> const auto & {
+        return capture_;
+    }
+
+    /** @brief Get the frames captured each time
+     *
+     * @return the number of frames
+     */
+    [[nodiscard]] inline auto get_capture_frames() const -> std::size_t {
+        return capture_frames_;
+    }
+
+    /** @brief Get the image format of the captured frames
+     *
+     * @return the image format
+     */
+    [[nodiscard]] inline auto get_capture_format() const -> sneze::capture_format {
+        return capture_format_;
+    }
+
+    /** @brief Get the folder to write the captured frames into
+     *
+     * @return const auto& The path of the folder
+     */
+    [[nodiscard]] inline auto get_capture_folder() const -> const auto & {
+        return capture_folder_;
+    }
+
+    /** @brief Get the file to dump the trace into
+     *
+     * @return const auto& The path of the file
+     */
+    [[nodiscard]] inline auto get_trace_file() const -> const auto & {
+        return trace_file_;
+    }
+
     /** @brief Get the window size
      *
      * @return const auto& The window size
@@ -263,6 +546,54 @@ public:
         return icon_;
     }
 
+    /** @brief Get if the input events are coalesced
+     *
+     * @return true if the input events are coalesced
+     */
+    [[nodiscard]] inline auto get_coalesce_input() const -> bool {
+        return coalesce_input_;
+    }
+
+    /** @brief Get if the input events are dispatched immediately
+     *
+     * @return true if the input events are dispatched immediately
+     */
+    [[nodiscard]] inline auto get_immediate_input() const -> bool {
+        return immediate_input_;
+    }
+
+    /** @brief Get the subsystems initialized at startup
+     *
+     * @return the subsystems initialized at startup, besides video and events
+     */
+    [[nodiscard]] inline auto get_subsystems() const -> device::subsystems {
+        return subsystems_;
+    }
+
+    /** @brief Get if the render drivers are probed at startup
+     *
+     * @return true if the render drivers are probed at startup
+     */
+    [[nodiscard]] inline auto get_probe_render_driver() const -> bool {
+        return probe_render_driver_;
+    }
+
+    /** @brief Get the frames per second to keep with dynamic resolution
+     *
+     * @return the frames per second to keep, 0 if the dynamic resolution is disabled
+     */
+    [[nodiscard]] inline auto get_dynamic_resolution_fps() const -> float {
+        return dynamic_resolution_fps_;
+    }
+
+    /** @brief Get the minimum scale of the resolution with dynamic resolution
+     *
+     * @return the minimum scale of the resolution
+     */
+    [[nodiscard]] inline auto get_dynamic_resolution_min_scale() const -> float {
+        return dynamic_resolution_min_scale_;
+    }
+
 private:
     //! The window size
     components::size window_ = {1920, 1080};
@@ -279,8 +610,47 @@ private:
     //! The toggle full screen key
     keyboard::key_modifier toggle_full_screen_ = {keyboard::key::unknown, keyboard::modifier::none};
 
+    //! The toggle profiler overlay key
+    keyboard::key_modifier toggle_profiler_overlay_ = {keyboard::key::unknown, keyboard::modifier::none};
+
+    //! The dump trace key
+    keyboard::key_modifier dump_trace_ = {keyboard::key::unknown, keyboard::modifier::none};
+
+    //! The file to dump the trace into
+    std::string trace_file_ = "sneze_trace.json";
+
+    //! The capture key
+    keyboard::key_modifier capture_ = {keyboard::key::unknown, keyboard::modifier::none};
+
+    //! The frames captured each time
+    std::size_t capture_frames_ = 1;
+
+    //! The image format of the captured frames
+    sneze::capture_format capture_format_ = sneze::capture_format::png;
+
+    //! The folder to write the captured frames into
+    std::string capture_folder_ = ".";
+
     //! The window icon
     std::string icon_ = embedded::sneze_logo;
+
+    //! If the input events are coalesced
+    bool coalesce_input_ = false;
+
+    //! If the input events are dispatched immediately
+    bool immediate_input_ = false;
+
+    //! The subsystems initialized at startup, besides video and events
+    device::subsystems subsystems_ = device::subsystem::none;
+
+    //! If the render drivers are probed at startup
+    bool probe_render_driver_ = false;
+
+    //! The frames per second to keep with dynamic resolution, 0 when it is disabled
+    float dynamic_resolution_fps_ = 0.F;
+
+    //! The minimum scale of the resolution with dynamic resolution
+    float dynamic_resolution_min_scale_ = 0.5F;
 };
 
 } // namespace sneze
@@ -0,0 +1,267 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#if defined(__clang__)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+#include <entt/entt.hpp>
+#if defined(__clang__)
+#    pragma clang diagnostic pop
+#endif
+
+#include "../platform/bounded_queue.hpp"
+#include "../platform/logger.hpp"
+#include "../platform/result.hpp"
+
+namespace sneze {
+
+//! what to do when an event is emitted into a full channel
+enum class overflow_policy {
+    //! discard the event emitted
+    drop_newest,
+    //! discard the oldest event in the channel to make room
+    drop_oldest
+};
+
+//! the statistics of an event channel, for monitoring
+struct event_channel_stats {
+    //! the number of events waiting in the channel
+    std::size_t depth = 0; // cppcheck-suppress unusedStructMember
+    //! the maximum number of events in the channel
+    std::size_t capacity = 0; // cppcheck-suppress unusedStructMember
+    //! the number of events discarded since the channel was open
+    std::uint64_t dropped = 0; // cppcheck-suppress unusedStructMember
+};
+
+//! base class of the event channels
+class event_channel_base {
+public:
+    event_channel_base() = default;
+    virtual ~event_channel_base() = default;
+
+    event_channel_base(const event_channel_base &) = delete;
+    event_channel_base(event_channel_base &&) = delete;
+    auto operator=(const event_channel_base &) -> event_channel_base & = delete;
+    auto operator=(event_channel_base &&) -> event_channel_base & = delete;
+
+    /**
+     * @brief move the events of the channel to a dispatcher
+     * @param dispatcher the dispatcher to enqueue the events into
+     */
+    virtual void drain(entt::dispatcher &dispatcher) = 0;
+
+    /**
+     * @brief get the statistics of the channel
+     * @return the statistics
+     */
+    [[nodiscard]] virtual auto stats() const -> event_channel_stats = 0;
+};
+
+/**
+ * @brief a channel of events of a type that any thread could emit into
+ *
+ * the events are stored in a sneze::bounded_queue without locks, when the channel is full the overflow_policy decide
+ * which event is discarded.
+ *
+ * @tparam EventType the type of the events
+ */
+template<typename EventType>
+class event_channel final: public event_channel_base {
+public:
+    /**
+     * @brief create a new channel
+     * @param capacity the maximum number of events in the channel
+     * @param overflow what to do when the channel is full
+     */
+    event_channel(std::size_t capacity, overflow_policy overflow): queue_{capacity}, overflow_{overflow} {}
+
+    /**
+     * @brief emit an event into the channel
+     * @param event the event to emit
+     */
+    void push(EventType &&event) {
+        while(!queue_.try_push(std::move(event))) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            if(overflow_ == overflow_policy::drop_newest) {
+                return;
+            }
+            // any other producer could take the free cell, so keep dropping until it fits
+            [[maybe_unused]] auto oldest = queue_.try_pop();
+        }
+    }
+
+    void drain(entt::dispatcher &dispatcher) override {
+        // only the events already in the channel, producers could keep emitting while draining
+        for(auto pending = queue_.size(); pending != 0; --pending) {
+            auto event = queue_.try_pop();
+            if(!event) {
+                break;
+            }
+            dispatcher.enqueue(std::move(*event));
+        }
+    }
+
+    [[nodiscard]] auto stats() const -> event_channel_stats override {
+        return {queue_.size(), queue_.capacity(), dropped_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    //! the events
+    bounded_queue<EventType> queue_;
+
+    //! what to do when the channel is full
+    overflow_policy overflow_;
+
+    //! the number of events discarded
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+/**
+ * @brief the event channels of the world, one for each type of event
+ *
+ * channels are found and open without locks so any thread could use them, a channel open by a thread is available
+ * for all the threads until the channels are cleared.
+ *
+ * @see world::emmit
+ */
+class event_channels {
+public:
+    //! maximum number of types of events with a channel
+    static constexpr std::size_t max_channels = 64;
+
+    //! the capacity of the channels open when a event is emitted before opening its channel
+    static constexpr std::size_t default_capacity = 1024;
+
+    event_channels() = default;
+    ~event_channels() {
+        clear();
+    }
+
+    event_channels(const event_channels &) = delete;
+    event_channels(event_channels &&) = delete;
+    auto operator=(const event_channels &) -> event_channels & = delete;
+    auto operator=(event_channels &&) -> event_channels & = delete;
+
+    /**
+     * @brief open the channel of a type of event
+     * @tparam EventType the type of the event
+     * @param capacity the maximum number of events in the channel
+     * @param overflow what to do when the channel is full
+     * @return true if the channel was open, error otherwise
+     */
+    template<typename EventType>
+    [[nodiscard]] auto open(std::size_t capacity, overflow_policy overflow) -> result<> {
+        const auto index = channel_index<EventType>();
+        if(index >= max_channels) {
+            logger::error("can not open more than {} event channels", max_channels);
+            return error("Too many event channels.");
+        }
+        if(!try_open<EventType>(index, capacity, overflow)) {
+            logger::error("event channel already open");
+            return error("Event channel already open.");
+        }
+        return true;
+    }
+
+    /**
+     * @brief get the channel of a type of event, opening it with the defaults if needed
+     * @tparam EventType the type of the event
+     * @return the channel, or nullptr if there are too many channels
+     */
+    template<typename EventType>
+    [[nodiscard]] auto get() -> event_channel<EventType> * {
+        const auto index = channel_index<EventType>();
+        if(index >= max_channels) {
+            logger::error("can not open more than {} event channels", max_channels);
+            return nullptr;
+        }
+        if(auto *channel = channels_[index].load(std::memory_order_acquire); channel != nullptr) {
+            return static_cast<event_channel<EventType> *>(channel);
+        }
+        try_open<EventType>(index, default_capacity, overflow_policy::drop_newest);
+        return static_cast<event_channel<EventType> *>(channels_[index].load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief get the statistics of the channel of a type of event
+     * @tparam EventType the type of the event
+     * @return the statistics, all zero if the channel is not open
+     */
+    template<typename EventType>
+    [[nodiscard]] auto stats() const -> event_channel_stats {
+        if(const auto index = channel_index<EventType>(); index < max_channels) {
+            if(const auto *channel = channels_[index].load(std::memory_order_acquire); channel != nullptr) {
+                return channel->stats();
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief move the events of all the channels to a dispatcher
+     * @param dispatcher the dispatcher to enqueue the events into
+     */
+    void drain(entt::dispatcher &dispatcher);
+
+    //! close all the channels, discarding their events
+    void clear();
+
+private:
+    //! open a channel if it was not open already
+    template<typename EventType>
+    auto try_open(std::size_t index, std::size_t capacity, overflow_policy overflow) -> bool {
+        auto channel = std::make_unique<event_channel<EventType>>(capacity, overflow);
+        event_channel_base *expected = nullptr;
+        if(channels_[index].compare_exchange_strong(expected, channel.get(), std::memory_order_acq_rel)) {
+            channel.release(); // NOLINT(bugprone-unused-return-value)
+            return true;
+        }
+        return false;
+    }
+
+    //! get the index of the channel of a type of event
+    template<typename EventType>
+    static auto channel_index() -> std::size_t {
+        static const auto index = next_channel_index();
+        return index;
+    }
+
+    //! get the next free index of the channels
+    static auto next_channel_index() -> std::size_t;
+
+    //! the channels, owned by this class
+    std::array<std::atomic<event_channel_base *>, max_channels> channels_{};
+};
+
+} // namespace sneze
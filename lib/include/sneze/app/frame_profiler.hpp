@@ -0,0 +1,99 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../globals/globals.hpp"
+
+namespace sneze {
+
+/**
+ * @brief keep the time of the sections of the recent frames
+ *
+ * the time of each section is recorded on a ring of the recent frames, at the end of each frame the statistics of the
+ * sections and the frames are calculated into the sneze::frame_profile global.
+ *
+ * @see sneze::world
+ */
+class frame_profiler {
+public:
+    //! the number of recent frames kept
+    static constexpr std::size_t frames = 120;
+
+    /**
+     * @brief set the sections to profile, forgetting the recent frames
+     * @param names the names of the sections
+     */
+    void reset(std::vector<std::string> names);
+
+    /**
+     * @brief record the time of a section on the current frame
+     * @param section the index of the section
+     * @param milliseconds the time of the section
+     */
+    void record(std::size_t section, float milliseconds) {
+        if(section < samples_.size()) {
+            samples_[section][next_] = milliseconds;
+        }
+    }
+
+    /**
+     * @brief end the current frame and calculate the statistics
+     * @param frame_time the time of the frame, in milliseconds
+     * @param profile the profile to update
+     */
+    void end_frame(float frame_time, frame_profile &profile);
+
+private:
+    //! the samples of the recent frames
+    using samples = std::array<float, frames>;
+
+    //! calculate the statistics of a section
+    void calculate(const samples &values, section_profile &section);
+
+    //! the names of the sections
+    std::vector<std::string> names_;
+
+    //! the samples of each section
+    std::vector<samples> samples_;
+
+    //! the time of the recent frames
+    samples frame_times_{};
+
+    //! the index of the current frame on the samples
+    std::size_t next_{0};
+
+    //! the number of recent frames recorded
+    std::size_t count_{0};
+
+    //! scratch space to calculate the percentiles
+    std::vector<float> sorted_;
+};
+
+} // namespace sneze
@@ -24,8 +24,17 @@ SOFTWARE.
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -40,9 +49,19 @@ SOFTWARE.
 #endif
 
 #include "../components/generic.hpp"
+#include "../components/hierarchy.hpp"
 #include "../events/events.hpp"
 #include "../globals/globals.hpp"
+#include "../platform/job_system.hpp"
+#include "../platform/logger.hpp"
+#include "../platform/result.hpp"
+#include "../platform/type_name.hpp"
 #include "../systems/system.hpp"
+#include "../systems/system_scheduler.hpp"
+
+#include "command_buffer.hpp"
+#include "event_channel.hpp"
+#include "frame_profiler.hpp"
 
 namespace sneze {
 
@@ -85,14 +104,72 @@ public:
      * @param args the values of the components to add to the entity
      * @return the entity id
      * @see world::remove_entity
+     * @see world::add_entities
      */
     template<typename... Args>
-    auto add_entity(Args... args) {
+    auto add_entity(Args &&...args) {
         auto entity_id = registry_.create();
-        recurse_create(entity_id, args...);
+        (set_component<std::decay_t<Args>>(entity_id, std::forward<Args>(args)), ...);
         return entity_id;
     }
 
+    /**
+     * @brief add several entities to the world, all of them with a copy of the same components
+     *
+     * The entities are created at once and each component is added to all of them at once, this is much faster than
+     * adding the entities one by one.
+     *
+     * @code
+     * auto particles = world->add_entities(10000, components::renderable{}, components::position{}, particle{});
+     * @endcode
+     *
+     * @tparam Components the types of the components to add to the entities
+     * @param count the number of entities to add
+     * @param prototype the components to add to each entity
+     * @return the entities ids
+     * @see world::add_entities_from
+     * @see world::remove_entities
+     */
+    template<typename... Components>
+    auto add_entities(std::size_t count, const Components &...prototype) -> std::vector<entt::entity> {
+        auto entities = std::vector<entt::entity>(count);
+        registry_.create(entities.begin(), entities.end());
+        (registry_.insert<Components>(entities.begin(), entities.end(), prototype), ...);
+        return entities;
+    }
+
+    /**
+     * @brief add several entities to the world, taking each component from a range
+     *
+     * An entity is added for each element of the ranges, the first entity gets the first element of each range, the
+     * second the second and so on. All the ranges must have the same size.
+     *
+     * @code
+     * auto tiles = world->add_entities_from(positions, sprites);
+     * @endcode
+     *
+     * @tparam Ranges the types of the ranges of components
+     * @param ranges the ranges of components, one for each type of component
+     * @return the entities ids
+     * @see world::add_entities
+     * @see world::remove_entities
+     */
+    template<std::ranges::sized_range... Ranges>
+    auto add_entities_from(const Ranges &...ranges) -> std::vector<entt::entity> {
+        static_assert(sizeof...(Ranges) != 0, "at least a range of components is required");
+        const auto count = std::ranges::size(std::get<0>(std::forward_as_tuple(ranges...)));
+        if(((std::ranges::size(ranges) != count) || ...)) {
+            logger::error("fail to add entities, the ranges of components have different sizes");
+            return {};
+        }
+        auto entities = std::vector<entt::entity>(count);
+        registry_.create(entities.begin(), entities.end());
+        (registry_.insert<std::ranges::range_value_t<Ranges>>(
+             entities.begin(), entities.end(), std::ranges::begin(ranges)),
+         ...);
+        return entities;
+    }
+
     /**
      * @brief remove an entity from the world
      * @param entity the entity id to remove
@@ -102,6 +179,67 @@ public:
         registry_.destroy(entity);
     }
 
+    /**
+     * @brief remove several entities from the world at once
+     * @tparam Range the type of the range of entities
+     * @param entities the entities ids to remove
+     * @see world::add_entities
+     * @see world::add_entities_from
+     */
+    template<std::ranges::range Range>
+    [[maybe_unused]] void remove_entities(const Range &entities) {
+        registry_.destroy(std::ranges::begin(entities), std::ranges::end(entities));
+    }
+
+    /**
+     * @brief reserve space for a number of components of each type
+     *
+     * Reserving the space before adding many entities avoids growing the storage of the components several times.
+     *
+     * @tparam Components the types of the components to reserve
+     * @param count the number of components to reserve of each type
+     * @see world::add_entities
+     */
+    template<typename... Components>
+    [[maybe_unused]] void reserve(std::size_t count) {
+        (registry_.storage<Components>().reserve(count), ...);
+    }
+
+    /**
+     * @brief check if an entity is valid, it was added and not removed
+     * @param entity the entity id to check
+     * @return true if the entity is valid
+     */
+    [[nodiscard]] auto is_valid(entt::entity entity) const -> bool {
+        return registry_.valid(entity);
+    }
+
+    /**
+     * @brief set the parent of an entity
+     *
+     * The position, scale and rotation of the entity become relative to its parent, the transform system calculates
+     * its components::world_transform that is used to render it.
+     *
+     * When an entity in a hierarchy is destroyed it is removed from the children of its parent, and its children
+     * become roots.
+     *
+     * @param entity the entity id
+     * @param parent the parent entity id
+     * @return true if the parent was set, error if any of the entities is not valid or the parent is the entity or one
+     * of its descendants
+     * @see world::remove_parent
+     * @see components::parent
+     * @see components::children
+     */
+    [[maybe_unused]] auto set_parent(entt::entity entity, entt::entity parent) -> result<>;
+
+    /**
+     * @brief remove the parent of an entity, its position, scale and rotation are no longer relative to a parent
+     * @param entity the entity id
+     * @see world::set_parent
+     */
+    [[maybe_unused]] void remove_parent(entt::entity entity);
+
     /**
      * @brief get a component from an entity
      * This function will return a reference to the component of the entity.
@@ -150,6 +288,120 @@ public:
         registry_.emplace<Type>(entity, std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief modify a component of an entity and mark it as changed
+     *
+     * @code
+     * world->patch<components::position>(entity, [](auto &position) { position.x += 10.0F; });
+     * @endcode
+     *
+     * @tparam Type the type of the component to modify
+     * @tparam Functions the types of the functions to call with the component
+     * @param entity the entity id that has the component
+     * @param functions the functions to call with a reference to the component
+     * @return a reference to the component
+     * @see world::mark_changed
+     * @see world::changed
+     */
+    template<typename Type, typename... Functions>
+    [[maybe_unused]] auto patch(entt::entity entity, Functions &&...functions) -> decltype(auto) {
+        return registry_.patch<Type>(entity, std::forward<Functions>(functions)...);
+    }
+
+    /**
+     * @brief mark a component of an entity as changed, after modifying it directly
+     * @tparam Type the type of the component that has changed
+     * @param entity the entity id that has the component
+     * @see world::patch
+     * @see world::changed
+     */
+    template<typename Type>
+    [[maybe_unused]] void mark_changed(entt::entity entity) {
+        registry_.patch<Type>(entity);
+    }
+
+    /**
+     * @brief start tracking the changes of a component on every frame
+     *
+     * After calling this function world::changed returns the entities that got the component or that the component
+     * was marked as changed since it was read on a previous frame.
+     *
+     * @tparam Type the type of the component to track
+     * @see world::changed
+     * @see world::observe_changes
+     */
+    template<typename Type>
+    void track_changes() {
+        const auto index = slot_index<Type>();
+        if(index >= change_trackers_.size()) {
+            change_trackers_.resize(index + 1);
+        }
+        if(auto &tracker = change_trackers_[index]; !tracker) {
+            tracker = std::make_unique<change_tracker>(observe_changes<Type>());
+        }
+    }
+
+    /**
+     * @brief get the entities that got a component or that the component was marked as changed since the last frame
+     * that it was read
+     *
+     * The first read on each frame takes the changes collected since the previous read, including the ones done by
+     * systems that run after the reader, listeners and commands, so no change is lost between frames. Other reads on
+     * the same frame get the same entities. If the changes of the component were not tracked they are tracked from now
+     * on.
+     *
+     * @code
+     * for(auto entity: world->changed<components::anchor>()) {
+     *     update_layout(entity);
+     * }
+     * @endcode
+     *
+     * @note changes should be done on the main thread, or using world::commands from systems that run in parallel, and
+     * the changes should be read on the main thread
+     *
+     * @tparam Type the type of the component
+     * @return the entities that have changed
+     * @see world::patch
+     * @see world::mark_changed
+     * @see world::track_changes
+     */
+    template<typename Type>
+    [[nodiscard]] auto changed() -> const std::vector<entt::entity> & {
+        track_changes<Type>();
+        auto &tracker = *change_trackers_[slot_index<Type>()];
+        if(!tracker.taken) {
+            tracker.entities.assign(tracker.observer->begin(), tracker.observer->end());
+            tracker.observer->clear();
+            tracker.taken = true;
+        }
+        return tracker.entities;
+    }
+
+    /**
+     * @brief observe the changes of components, for a consumer that decides when the changes are forgotten
+     *
+     * The observer collects the entities that got any of the components or that any of the components was marked as
+     * changed, until it is cleared.
+     *
+     * @code
+     * for(auto entity: *observer) {
+     *     refresh_cache(entity);
+     * }
+     * observer->clear();
+     * @endcode
+     *
+     * @note the observer must be destroyed before the world
+     *
+     * @tparam Types the types of the components to observe
+     * @return an observer of the changes
+     * @see world::changed
+     */
+    template<typename... Types>
+    [[nodiscard]] auto observe_changes() -> std::unique_ptr<entt::observer> {
+        static_assert(sizeof...(Types) != 0, "at least a component type is required");
+        return std::make_unique<entt::observer>(registry_, collect_changes<Types...>(entt::collector));
+    }
+
     /**
      * @brief check if an entity has a component
      * This function will check if an entity has a component.
@@ -179,6 +431,117 @@ public:
         return registry_.view<Types...>().each();
     }
 
+    /**
+     * @brief call a function for all the entities that have the components, using the job system
+     *
+     * The entities are split in chunks that run in parallel, if there are less entities than the chunk size they are
+     * processed in the calling thread. This function returns when all the entities are processed.
+     *
+     * The function is called with the entity and a reference to each of the components, it could run in any thread
+     * so it should only modify the components of the entity that is given.
+     *
+     * note: the components must not be empty types, use tags with world::get_tagged instead
+     *
+     * note: a system that runs in parallel must declare the components in its access, so their storages exist before it
+     * runs and getting the view does not modify the registry
+     *
+     * @code
+     * world->parallel_each<components::position, velocity>(
+     *     [delta](entt::entity, components::position &position, const velocity &velocity) {
+     *         position.x += velocity.x * delta;
+     *         position.y += velocity.y * delta;
+     *     });
+     * @endcode
+     *
+     * @tparam Types the types of the components to check
+     * @tparam Function the type of the function, void(entt::entity, Types &...)
+     * @param function the function to call for each entity
+     * @param chunk_size the number of entities that each job process
+     * @see world::get_entities
+     * @see world::jobs
+     */
+    template<typename... Types, typename Function>
+    void parallel_each(Function function, std::size_t chunk_size = default_chunk_size) {
+        auto view = registry_.view<Types...>();
+        auto process = [&view, &function](entt::entity entity) {
+            function(entity, view.template get<Types>(entity)...);
+        };
+
+        auto estimated = std::size_t{0};
+        if constexpr(sizeof...(Types) == 1) {
+            estimated = view.size();
+        } else {
+            estimated = view.size_hint();
+        }
+
+        if(jobs_.size() == 1 || estimated <= chunk_size) {
+            for(auto entity: view) {
+                process(entity);
+            }
+            return;
+        }
+
+        auto entities = std::vector<entt::entity>(view.begin(), view.end());
+        jobs_.parallel_for(entities.size(), chunk_size, [&entities, &process](std::size_t begin, std::size_t end) {
+            for(auto index = begin; index < end; ++index) {
+                process(entities[index]);
+            }
+        });
+    }
+
+    /**
+     * @brief get the command buffer of the calling thread
+     *
+     * The command buffer records structural changes, create and destroy entities or add and remove components, that
+     * the world applies after the systems are updated and after the events are sent. Use it to change the world while
+     * iterating entities or from systems that run in parallel.
+     *
+     * note: only the main thread and the threads of the job system have a command buffer, other threads get the buffer
+     * of the main thread and an error is logged, they should use world::emmit to ask the main thread for the changes
+     *
+     * @code
+     * for(auto const &&[entity, bullet]: world->get_entities<bullet>()) {
+     *     if(bullet.life < 0.0F) {
+     *         world->commands().destroy(entity);
+     *     }
+     * }
+     * @endcode
+     *
+     * @return the command buffer
+     * @see sneze::command_buffer
+     */
+    [[nodiscard]] auto commands() -> command_buffer & {
+        const auto worker = job_system::current_worker();
+        if(worker == 0 && std::this_thread::get_id() != main_thread_) [[unlikely]] {
+            logger::error("world::commands used from a thread that is not the main thread or a job system worker");
+        }
+        return command_buffers_[std::min(worker, command_buffers_.size() - 1)];
+    }
+
+    //! maximum number of times that the events are dispatched on each update, to handle events sent by listeners
+    static constexpr std::size_t max_event_passes = 4;
+
+    /**
+     * @brief get the current time of the world
+     * @return the time since the world was initialized, in milliseconds
+     * @see game_time
+     */
+    [[nodiscard]] auto now() const -> double {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time_).count();
+    }
+
+    /**
+     * @brief get the job system of the world
+     * @return the job system
+     * @see world::parallel_each
+     */
+    [[nodiscard]] auto jobs() noexcept -> job_system & {
+        return jobs_;
+    }
+
+    //! default number of entities for each job of world::parallel_each
+    static constexpr std::size_t default_chunk_size = 256;
+
     /**
      * @brief tag an entity
      * @tparam TagType the type of the tag to add
@@ -228,9 +591,10 @@ public:
      */
     template<typename TagType>
     void remove_all_tagged() {
-        for(auto &&[entity]: get_tagged<TagType>()) {
-            remove_entity(entity);
-        }
+        // collect the entities first, destroying them while iterating the view is not safe
+        auto view = registry_.view<components::tag<TagType>>();
+        auto entities = std::vector<entt::entity>(view.begin(), view.end());
+        registry_.destroy(entities.begin(), entities.end());
     }
 
     /**
@@ -243,21 +607,19 @@ public:
      */
     template<typename TagType>
     void remove_all_tags() {
-        for(auto &&[entity]: get_tagged<TagType>()) {
-            untag<TagType>(entity);
-        }
+        registry_.clear<components::tag<TagType>>();
     }
 
     /**
-     * @brief set a global entity
-     * A global entity is an entity that is always present in the world and can be accessed by any system, but its only
-     * exists in one entity. This function will set the global entity to the given value.
+     * @brief set a global
+     * A global is a value that is always present in the world and can be accessed by any system, but there is only one
+     * of each type. This function will set the global to the given value.
      *
-     * @note the global entity must have a default initializer, otherwise the function will fail to compile
+     * @note the global must have a default initializer, otherwise the function will fail to compile
      *
-     * @tparam Type of the global entity
-     * @tparam Args arguments type to pass to the global entity constructor
-     * @param args arguments to pass to the global entity constructor
+     * @tparam Type of the global
+     * @tparam Args arguments type to pass to the global constructor
+     * @param args arguments to pass to the global constructor
      */
     template<typename Type, typename... Args>
     [[maybe_unused]] void set_global(Args &&...args) {
@@ -267,40 +629,50 @@ public:
     }
 
     /**
-     * @brief get a global entity
-     * A global entity is an entity that is always present in the world and can be accessed by any system, but its only
-     * exists in one entity. This function will return a reference to the global entity.
+     * @brief get a global
+     * A global is a value that is always present in the world and can be accessed by any system, but there is only one
+     * of each type. This function will return a reference to the global.
      *
-     * If the global entity does not exist, it will be created with the default initializer.
+     * If the global does not exist, it will be created with the default initializer.
      *
-     * @note the global entity must have a default initializer, otherwise the function will fail to compile
+     * The reference is stable until the global is removed or the world is cleared, so a system could keep it across
+     * frames instead of getting it each update.
      *
-     * @tparam Type of the global entity
-     * @return a reference to the global component
+     * @note the global must have a default initializer, otherwise the function will fail to compile
+     * @note a global should be created from the main thread, before any system that runs in parallel gets it
+     *
+     * @tparam Type of the global
+     * @return a reference to the global
      */
     template<typename Type>
-    [[maybe_unused]] [[nodiscard]] auto get_global() -> auto & {
+    [[maybe_unused]] [[nodiscard]] auto get_global() -> Type & {
         static_assert(std::default_initializable<Type>, "the type must have a default initializer");
-        if(auto first = registry_.view<Type, components::tag<global<Type>>>().front(); !(first == entt::null)) {
-            return get_component<Type>(first);
+        const auto index = slot_index<Type>();
+        if(index >= globals_.size()) [[unlikely]] {
+            globals_.resize(index + 1);
+        }
+        auto &slot = globals_[index];
+        if(!slot) [[unlikely]] {
+            slot = std::make_shared<Type>();
         }
-        tag<global<Type>>(add_entity(Type{}));
-        return get_global<Type>();
+        return *static_cast<Type *>(slot.get());
     }
 
     /**
-     * @brief remove a global entity
-     * A global entity is an entity that is always present in the world and can be accessed by any system, but its only
-     * exists in one entity. This function will remove the global entity.
+     * @brief remove a global
+     * A global is a value that is always present in the world and can be accessed by any system, but there is only one
+     * of each type. This function will remove the global.
      *
-     * @note the global entity must have a default initializer, otherwise the function will fail to compile
+     * @note the global must have a default initializer, otherwise the function will fail to compile
      *
-     * @tparam Type of the global entity
+     * @tparam Type of the global
      */
     template<typename Type>
     [[maybe_unused]] void remove_global() {
         static_assert(std::default_initializable<Type>, "the type must have a default initializer");
-        remove_all_tagged<global<Type>>();
+        if(const auto index = slot_index<Type>(); index < globals_.size()) {
+            globals_[index].reset();
+        }
     }
 
     /**
@@ -324,16 +696,25 @@ public:
      *
      * When the world is updated, the system will be updated in the order of the priority.
      *
+     * The component and global types that the system reads and writes could be declared, systems that do not conflict
+     * will run in parallel, if not declared the system uses system::access.
+     *
+     * @code
+     * world->add_system<movement_system, reads<game_time, velocity>, writes<components::position>>();
+     * @endcode
+     *
      * @tparam SystemType the type of the system to add
+     * @tparam Access the access of the system, any of sneze::reads, sneze::writes or sneze::main_thread
      * @tparam Args the types of the arguments to pass to the system constructor
      * @param args the arguments to pass to the system constructor
      * @see world::add_system_with_priority
      * @see world::remove_system
+     * @see sneze::system_access
      */
-    template<typename SystemType, typename... Args>
-    [[maybe_unused]] void add_system(Args... args) noexcept {
+    template<typename SystemType, typename... Access, typename... Args>
+    [[maybe_unused]] void add_system(Args &&...args) noexcept {
         static_assert(std::is_base_of<system, SystemType>::value, "the system to add must implement sneze::system");
-        add_system_with_priority<priority::normal, SystemType>(args...);
+        add_system_with_priority<priority::normal, SystemType, Access...>(std::forward<Args>(args)...);
     }
 
     /**
@@ -347,17 +728,18 @@ public:
      *
      * @tparam Priority the priority of the system
      * @tparam SystemType the type of the system to add
+     * @tparam Access the access of the system, any of sneze::reads, sneze::writes or sneze::main_thread
      * @tparam Args the types of the arguments to pass to the system constructor
      * @param args the arguments to pass to the system constructor
      * @see world::add_system
      * @see world::remove_system
      */
-    template<int32_t Priority, typename SystemType, typename... Args>
-    [[maybe_unused]] void add_system_with_priority(Args... args) noexcept {
+    template<int32_t Priority, typename SystemType, typename... Access, typename... Args>
+    [[maybe_unused]] void add_system_with_priority(Args &&...args) noexcept {
         static_assert(std::is_base_of<system, SystemType>::value, "the system to add must implement sneze::system");
         static_assert(Priority >= world::priority::low && Priority <= world::priority::high,
                       "priority must be between priority::low (-1000) and priority::high (1000)");
-        add_system_with_priority_internal<Priority, SystemType>(args...);
+        add_system_with_priority_internal<Priority, SystemType, Access...>(std::forward<Args>(args)...);
     }
 
     /**
@@ -404,13 +786,63 @@ public:
     }
 
     /**
-     * @brief remove all listeners from an instance
+     * @brief add a listener that receives at once all the events of a type dispatched on a frame
+     *
+     * The listener is called once per frame, after the events are dispatched, with a span of all of them, so it could
+     * handle them in a single pass instead of once for each event.
+     *
+     * @code
+     * void my_game::mouse_moved(std::span<const sneze::events::mouse_moved> events) {
+     *     cursor_ = events.back().point;
+     * }
+     * @endcode
+     *
+     * @tparam EventType the type of the event to listen to
+     * @tparam Candidate the function to call with the events, void(std::span<const EventType>)
+     * @tparam InstanceType the type of the instance to call the function on
+     * @param instance the instance to call the function on
+     * @see world::remove_batch_listener
+     */
+    template<typename EventType, auto Candidate, typename InstanceType>
+    void add_batch_listener(InstanceType &&instance) {
+        static_assert(std::is_base_of<events::event, EventType>::value,
+                      "the event must be a descendant of sneze::events::event");
+        entt::sink{get_event_batch<EventType>().signal}.template connect<Candidate>(instance);
+    }
+
+    /**
+     * @brief remove all batch listeners from an event
+     * @tparam EventType the type of the event to remove the batch listeners from
+     * @tparam InstanceType the type of the instance to remove the batch listeners from
+     * @param instance the instance to remove the batch listeners from
+     * @see world::add_batch_listener
+     */
+    template<typename EventType, typename InstanceType>
+    [[maybe_unused]] void remove_batch_listener(InstanceType &&instance) {
+        static_assert(std::is_base_of<events::event, EventType>::value,
+                      "the event must be a descendant of sneze::events::event");
+        entt::sink{get_event_batch<EventType>().signal}.disconnect(instance);
+    }
+
+    /**
+     * @brief remove all listeners from an instance, including batch listeners
      * @tparam InstanceType the type of the instance to remove the listeners from
      * @param instance the instance to remove the listeners from
      */
     template<typename InstanceType>
     [[maybe_unused]] void remove_listeners(InstanceType &&instance) {
         event_dispatcher_.disconnect(instance);
+        const auto *address = address_of(instance);
+        for(auto &batch: event_batches_) {
+            if(batch) {
+                batch->disconnect(address);
+            }
+        }
+        for(auto &hooks: component_hooks_) {
+            if(hooks) {
+                hooks->disconnect(address);
+            }
+        }
     }
 
     /**
@@ -418,18 +850,80 @@ public:
      *
      * Enqueue an event to be dispatched. The event will be dispatched at the end of the current update.
      *
+     * Events emitted from other threads than the main thread go into the event channel of their type, without locks,
+     * and are dispatched with the other events at the end of the update.
+     *
      * @note the event must be a descendant of sneze::event
      *
      * @tparam EventType the type of the event to enqueue
      * @tparam Args the types of the arguments to pass to the event constructor
      * @param args the arguments to pass to the event constructor
      * @see world::add_listener
+     * @see world::open_event_channel
      */
     template<typename EventType, typename... Args>
     void emmit(Args &&...args) {
         static_assert(std::is_base_of<events::event, EventType>::value,
                       "the event must be a descendant of sneze::events::event");
-        event_dispatcher_.enqueue<EventType>(this, std::forward<Args>(args)...);
+        if(std::this_thread::get_id() == main_thread_) {
+            event_dispatcher_.enqueue<EventType>(this, std::forward<Args>(args)...);
+        } else if(auto *channel = event_channels_.get<EventType>(); channel != nullptr) {
+            channel->push(EventType{this, std::forward<Args>(args)...});
+        }
+    }
+
+    /**
+     * @brief open the channel for the events of a type emitted from other threads
+     *
+     * Channels are open with a capacity of event_channels::default_capacity, dropping the newest events, the first
+     * time that an event of its type is emitted from other thread than the main thread, use this function before to
+     * choose other capacity or overflow policy.
+     *
+     * @tparam EventType the type of the event
+     * @param capacity the maximum number of events waiting in the channel
+     * @param overflow what to do when the channel is full
+     * @return true if the channel was open, error otherwise
+     * @see world::emmit
+     */
+    template<typename EventType>
+    [[maybe_unused]] [[nodiscard]] auto open_event_channel(std::size_t capacity,
+                                                           overflow_policy overflow = overflow_policy::drop_newest)
+        -> result<> {
+        if(auto err = event_channels_.open<EventType>(capacity, overflow).ko(); err) {
+            return error("Can't open event channel.", *err);
+        }
+        return true;
+    }
+
+    /**
+     * @brief get the statistics of the channel for the events of a type emitted from other threads
+     * @tparam EventType the type of the event
+     * @return the depth, capacity and events dropped of the channel, all zero if is not open
+     */
+    template<typename EventType>
+    [[maybe_unused]] [[nodiscard]] auto get_event_channel_stats() const -> event_channel_stats {
+        return event_channels_.stats<EventType>();
+    }
+
+    /**
+     * @brief dispatch an event immediately
+     *
+     * Unlike world::emmit the event is not queued, the listeners are called before this function returns.
+     *
+     * @note the event must be a descendant of sneze::event
+     * @note it should be only called from the main thread
+     *
+     * @tparam EventType the type of the event to dispatch
+     * @tparam Args the types of the arguments to pass to the event constructor
+     * @param args the arguments to pass to the event constructor
+     * @see world::add_listener
+     * @see world::emmit
+     */
+    template<typename EventType, typename... Args>
+    void trigger(Args &&...args) {
+        static_assert(std::is_base_of<events::event, EventType>::value,
+                      "the event must be a descendant of sneze::events::event");
+        event_dispatcher_.trigger(EventType{this, std::forward<Args>(args)...});
     }
 
     /**
@@ -468,6 +962,74 @@ public:
         remove_listener<events::add_component<ComponentType>>(instance);
     }
 
+    /**
+     * @brief add a listener to the construction, update or destruction of a component type
+     *
+     * The listener is called immediately, with the entity and a reference to the component instead of a copy:
+     * - void(entt::entity, ComponentType &) on events::lifecycle::construct and events::lifecycle::update
+     * - void(entt::entity, const ComponentType &) on events::lifecycle::destroy, before the component is removed
+     *
+     * @code
+     * world->add_component_listener<sneze::events::lifecycle::update, label, &my_game::label_updated>(this);
+     * @endcode
+     *
+     * @note updates are only notified when the component is changed with world::patch, world::mark_changed or it is
+     * set again
+     *
+     * @tparam Lifecycle the moment on the life of the component to listen to
+     * @tparam ComponentType the type of the component to listen to
+     * @tparam Candidate the function to call
+     * @tparam InstanceType the type of the instance to call the function on
+     * @param instance the instance to call the function on
+     * @see world::add_component_batch_listener
+     * @see world::remove_component_listener
+     */
+    template<events::lifecycle Lifecycle, typename ComponentType, auto Candidate, typename InstanceType>
+    [[maybe_unused]] void add_component_listener(InstanceType &&instance) {
+        entt::sink{get_component_hooks<ComponentType>().template signal<Lifecycle>()}.template connect<Candidate>(
+            instance);
+    }
+
+    /**
+     * @brief add a listener that receives once per frame all the entities with a component constructed, updated or
+     * destroyed
+     *
+     * The listener is called after the events of the frame are dispatched, with each entity only once:
+     * void(std::span<const entt::entity>), the components are not copied, on events::lifecycle::destroy the entities
+     * may not be valid anymore.
+     *
+     * @tparam Lifecycle the moment on the life of the component to listen to
+     * @tparam ComponentType the type of the component to listen to
+     * @tparam Candidate the function to call
+     * @tparam InstanceType the type of the instance to call the function on
+     * @param instance the instance to call the function on
+     * @see world::add_component_listener
+     * @see world::remove_component_listener
+     */
+    template<events::lifecycle Lifecycle, typename ComponentType, auto Candidate, typename InstanceType>
+    [[maybe_unused]] void add_component_batch_listener(InstanceType &&instance) {
+        entt::sink{get_component_hooks<ComponentType>().template batch<Lifecycle>().signal}
+            .template connect<Candidate>(instance);
+    }
+
+    /**
+     * @brief remove the listeners, immediate and batched, of an instance to a moment on the life of a component type
+     *
+     * @tparam Lifecycle the moment on the life of the component to remove the listeners from
+     * @tparam ComponentType the type of the component to remove the listeners from
+     * @tparam InstanceType the type of the instance to remove the listeners from
+     * @param instance the instance to remove the listeners from
+     * @see world::add_component_listener
+     * @see world::add_component_batch_listener
+     */
+    template<events::lifecycle Lifecycle, typename ComponentType, typename InstanceType>
+    [[maybe_unused]] void remove_component_listener(InstanceType &&instance) {
+        if(auto *hooks = find_component_hooks<ComponentType>(); hooks != nullptr) {
+            entt::sink{hooks->template signal<Lifecycle>()}.disconnect(address_of(instance));
+            entt::sink{hooks->template batch<Lifecycle>().signal}.disconnect(address_of(instance));
+        }
+    }
+
     /**
      * @brief remove all listeners to components of type in entity
      *
@@ -476,10 +1038,15 @@ public:
      * @param instance the instance to remove the listeners from
      * @see world::add_listener_to_add_component
      * @see world::remove_listener_to_add_component
+     * @see world::add_component_listener
+     * @see world::add_component_batch_listener
      */
     template<typename ComponentType, typename InstanceType>
     [[maybe_unused]] void remove_component_listeners(InstanceType &&instance) {
         remove_listener_to_add_component<ComponentType>(instance);
+        if(auto *hooks = find_component_hooks<ComponentType>(); hooks != nullptr) {
+            hooks->disconnect(address_of(instance));
+        }
     }
 
 protected:
@@ -524,28 +1091,37 @@ protected:
      *
      * @tparam Priority the priority of the system
      * @tparam SystemType the type of the system to add
+     * @tparam Access the access of the system, any of sneze::reads, sneze::writes or sneze::main_thread
      * @tparam Args the types of the arguments to pass to the system constructor
      * @param args the arguments to pass to the system constructor
      * @see world::add_system
      * @see world::remove_system
      */
-    template<int32_t Priority, typename SystemType, typename... Args>
-    [[maybe_unused]] void add_system_with_priority_internal(Args... args) noexcept {
+    template<int32_t Priority, typename SystemType, typename... Access, typename... Args>
+    [[maybe_unused]] void add_system_with_priority_internal(Args &&...args) noexcept {
         static_assert(std::is_base_of<system, SystemType>::value, "the system to add must implement sneze::system");
         static_assert(Priority >= world::priority::after_applications
                           && Priority <= world::priority::before_applications,
                       "priority must be between priority::after_applications and priority::before_applications");
-        add_system_with_priority_unrestricted<Priority, SystemType>(args...);
+        add_system_with_priority_unrestricted<Priority, SystemType, Access...>(std::forward<Args>(args)...);
     }
 
 private:
     //! add system with priority, without checking the priority, enqueue the system to be added
-    template<int32_t Priority, typename SystemType, typename... Args>
-    [[maybe_unused]] void add_system_with_priority_unrestricted(Args... args) noexcept {
+    template<int32_t Priority, typename SystemType, typename... Access, typename... Args>
+    [[maybe_unused]] void add_system_with_priority_unrestricted(Args &&...args) noexcept {
         static_assert(std::is_base_of<system, SystemType>::value, "the system to add must implement sneze::system");
         auto constexpr type_hash = entt::type_hash<SystemType>::value();
+        auto access = std::optional<system_access>{};
+        if constexpr(sizeof...(Access) != 0) {
+            access = system_access::from<Access...>();
+        }
         systems_to_add_.push_back(
-            std::make_unique<system_with_priority>(type_hash, Priority, std::make_unique<SystemType>(args...)));
+            std::make_unique<system_with_priority>(type_hash,
+                                                   std::string{type_name<SystemType>()},
+                                                   Priority,
+                                                   std::make_unique<SystemType>(std::forward<Args>(args)...),
+                                                   std::move(access)));
     }
 
     //! internal add listener to add component
@@ -555,9 +1131,245 @@ private:
         emmit<events::add_component<ComponentType>>(entity, component);
     }
 
-    //! global tag
+    //! build a collector of the entities that get or update any of the components
+    template<typename Type, typename... Others, typename Collector>
+    static auto collect_changes(Collector collector) {
+        auto next = collector.template group<Type>().template update<Type>();
+        if constexpr(sizeof...(Others) == 0) {
+            return next;
+        } else {
+            return collect_changes<Others...>(next);
+        }
+    }
+
+    //! base of the batches of events
+    struct event_batch_base {
+        virtual ~event_batch_base() = default;
+
+        //! deliver the events collected to the batch listeners
+        virtual void deliver() = 0;
+
+        //! disconnect the batch listeners of an instance
+        virtual void disconnect(const void *instance) = 0;
+    };
+
+    //! the events of a type dispatched on a frame, and their batch listeners
+    template<typename EventType>
+    struct event_batch final: event_batch_base {
+        //! the events collected
+        std::vector<EventType> events{};
+        //! the events being delivered
+        std::vector<EventType> delivering{};
+        //! the batch listeners
+        entt::sigh<void(std::span<const EventType>)> signal{};
+
+        //! collect an event
+        void collect(const EventType &event) {
+            events.push_back(event);
+        }
+
+        //! deliver the events, listeners could trigger new events while delivering
+        void deliver() override {
+            if(events.empty()) {
+                return;
+            }
+            delivering.swap(events);
+            signal.publish(std::span<const EventType>{delivering});
+            delivering.clear();
+        }
+
+        //! disconnect the batch listeners of an instance
+        void disconnect(const void *instance) override {
+            entt::sink{signal}.disconnect(instance);
+        }
+    };
+
+    //! get the batch of events of a type, creating it if needed
+    template<typename EventType>
+    auto get_event_batch() -> event_batch<EventType> & {
+        const auto index = slot_index<event_batch<EventType>>();
+        if(index >= event_batches_.size()) {
+            event_batches_.resize(index + 1);
+        }
+        auto &slot = event_batches_[index];
+        if(!slot) {
+            auto batch = std::make_unique<event_batch<EventType>>();
+            event_dispatcher_.sink<EventType>().template connect<&event_batch<EventType>::collect>(*batch);
+            slot = std::move(batch);
+        }
+        return static_cast<event_batch<EventType> &>(*slot);
+    }
+
+    //! the entities of a moment on the life of a component on a frame, and their batch listeners
+    struct entity_batch {
+        //! the entities collected
+        std::vector<entt::entity> entities{};
+        //! the entities being delivered
+        std::vector<entt::entity> delivering{};
+        //! the batch listeners
+        entt::sigh<void(std::span<const entt::entity>)> signal{};
+
+        //! collect an entity, only if there are listeners
+        void collect(entt::entity entity) {
+            if(!signal.empty()) {
+                entities.push_back(entity);
+            }
+        }
+
+        //! deliver each entity collected once, listeners could change components while delivering
+        void deliver() {
+            if(entities.empty()) {
+                return;
+            }
+            delivering.swap(entities);
+            std::sort(delivering.begin(), delivering.end());
+            delivering.erase(std::unique(delivering.begin(), delivering.end()), delivering.end());
+            signal.publish(std::span<const entt::entity>{delivering});
+            delivering.clear();
+        }
+    };
+
+    //! base of the listeners to the life of the components
+    struct component_hooks_base {
+        virtual ~component_hooks_base() = default;
+
+        //! deliver the entities collected to the batch listeners
+        virtual void deliver() = 0;
+
+        //! disconnect the listeners of an instance
+        virtual void disconnect(const void *instance) = 0;
+
+        //! stop listening to the registry
+        virtual void detach(entt::registry &registry) = 0;
+    };
+
+    //! the listeners to the life of a component type
+    template<typename ComponentType>
+    struct component_hooks final: component_hooks_base {
+        //! the listeners to the construction
+        entt::sigh<void(entt::entity, ComponentType &)> constructed{};
+        //! the listeners to the updates
+        entt::sigh<void(entt::entity, ComponentType &)> updated{};
+        //! the listeners to the destruction
+        entt::sigh<void(entt::entity, const ComponentType &)> destroyed{};
+        //! the batches, one for each moment on the life of the component
+        std::array<entity_batch, 3> batches{};
+
+        //! get the listeners to a moment on the life of the component
+        template<events::lifecycle Lifecycle>
+        auto signal() -> auto & {
+            if constexpr(Lifecycle == events::lifecycle::construct) {
+                return constructed;
+            } else if constexpr(Lifecycle == events::lifecycle::update) {
+                return updated;
+            } else {
+                return destroyed;
+            }
+        }
+
+        //! get the batch of a moment on the life of the component
+        template<events::lifecycle Lifecycle>
+        auto batch() -> entity_batch & {
+            return batches[static_cast<std::size_t>(Lifecycle)];
+        }
+
+        //! listen to the registry
+        void attach(entt::registry &registry) {
+            registry.on_construct<ComponentType>().template connect<&component_hooks::on_construct>(*this);
+            registry.on_update<ComponentType>().template connect<&component_hooks::on_update>(*this);
+            registry.on_destroy<ComponentType>().template connect<&component_hooks::on_destroy>(*this);
+        }
+
+        void detach(entt::registry &registry) override {
+            registry.on_construct<ComponentType>().disconnect(*this);
+            registry.on_update<ComponentType>().disconnect(*this);
+            registry.on_destroy<ComponentType>().disconnect(*this);
+        }
+
+        void deliver() override {
+            for(auto &entities: batches) {
+                entities.deliver();
+            }
+        }
+
+        void disconnect(const void *instance) override {
+            entt::sink{constructed}.disconnect(instance);
+            entt::sink{updated}.disconnect(instance);
+            entt::sink{destroyed}.disconnect(instance);
+            for(auto &entities: batches) {
+                entt::sink{entities.signal}.disconnect(instance);
+            }
+        }
+
+        //! a component was constructed in the registry
+        void on_construct(entt::registry &registry, entt::entity entity) {
+            notify<events::lifecycle::construct>(registry, entity);
+        }
+
+        //! a component was updated in the registry
+        void on_update(entt::registry &registry, entt::entity entity) {
+            notify<events::lifecycle::update>(registry, entity);
+        }
+
+        //! a component is going to be destroyed in the registry
+        void on_destroy(entt::registry &registry, entt::entity entity) {
+            notify<events::lifecycle::destroy>(registry, entity);
+        }
+
+        //! notify the listeners of a moment on the life of the component
+        template<events::lifecycle Lifecycle>
+        void notify(entt::registry &registry, entt::entity entity) {
+            if(auto &listeners = signal<Lifecycle>(); !listeners.empty()) {
+                listeners.publish(entity, registry.get<ComponentType>(entity));
+            }
+            batch<Lifecycle>().collect(entity);
+        }
+    };
+
+    //! get the listeners to the life of a component type, creating them if needed
+    template<typename ComponentType>
+    auto get_component_hooks() -> component_hooks<ComponentType> & {
+        const auto index = slot_index<component_hooks<ComponentType>>();
+        if(index >= component_hooks_.size()) {
+            component_hooks_.resize(index + 1);
+        }
+        auto &slot = component_hooks_[index];
+        if(!slot) {
+            auto hooks = std::make_unique<component_hooks<ComponentType>>();
+            hooks->attach(registry_);
+            slot = std::move(hooks);
+        }
+        return static_cast<component_hooks<ComponentType> &>(*slot);
+    }
+
+    //! find the listeners to the life of a component type, nullptr if there are none
+    template<typename ComponentType>
+    auto find_component_hooks() -> component_hooks<ComponentType> * {
+        if(const auto index = slot_index<component_hooks<ComponentType>>(); index < component_hooks_.size()) {
+            return static_cast<component_hooks<ComponentType> *>(component_hooks_[index].get());
+        }
+        return nullptr;
+    }
+
+    //! get the address of an instance, given as a reference or a pointer
+    template<typename InstanceType>
+    static auto address_of(InstanceType &&instance) -> const void * {
+        if constexpr(std::is_pointer_v<std::remove_reference_t<InstanceType>>) {
+            return instance;
+        } else {
+            return &instance;
+        }
+    }
+
+    //! get the index of the slot of a type, for globals, change trackers and batches of events
     template<typename Type>
-    struct global {};
+    static auto slot_index() -> std::size_t {
+        static const auto index = next_slot_index();
+        return index;
+    }
+
+    //! get the next free index of the slots
+    static auto next_slot_index() -> std::size_t;
 
     //! system ptr with priority
     using system_ptr = std::unique_ptr<system_with_priority>;
@@ -571,6 +1383,9 @@ private:
     //! the time that the world was created since the epoch
     game_time start_;
 
+    //! the time point when the world was initialized, for world::now
+    std::chrono::steady_clock::time_point start_time_ = std::chrono::steady_clock::now();
+
     //! the current time since start
     game_time current_;
 
@@ -583,12 +1398,69 @@ private:
     //! the systems to remove
     systems_id_vector systems_to_remove_;
 
+    //! run the systems in parallel following their access
+    system_scheduler scheduler_;
+
+    //! the time of the systems and the events on the recent frames
+    frame_profiler profiler_;
+
+    //! when the last update started, to measure the frame time for the profiler
+    std::chrono::high_resolution_clock::time_point frame_start_{};
+
+    //! the command buffers, one for each thread of the job system
+    std::vector<command_buffer> command_buffers_ = std::vector<command_buffer>(1);
+
     //! the registry
     entt::registry registry_;
 
+    //! the globals, a slot for each type of global
+    std::vector<std::shared_ptr<void>> globals_;
+
+    //! the changes of a component, collected by an observer until they are read
+    struct change_tracker {
+        //! create a change tracker from an observer
+        explicit change_tracker(std::unique_ptr<entt::observer> changes): observer{std::move(changes)} {}
+        //! the observer that collects the changes
+        std::unique_ptr<entt::observer> observer;
+        //! the entities taken from the observer on the last read
+        std::vector<entt::entity> entities{};
+        //! if the entities were taken on this frame
+        bool taken{false};
+    };
+
+    //! the changes tracked, a slot for each type of component
+    std::vector<std::unique_ptr<change_tracker>> change_trackers_;
+
     //! the event dispatcher
     entt::dispatcher event_dispatcher_;
 
+    //! the batches of events, a slot for each type of event with batch listeners
+    std::vector<std::unique_ptr<event_batch_base>> event_batches_;
+
+    //! the listeners to the life of the components, a slot for each type of component with listeners
+    std::vector<std::unique_ptr<component_hooks_base>> component_hooks_;
+
+    //! the channels of the events emitted from other threads
+    event_channels event_channels_;
+
+    //! the thread that update the world
+    std::thread::id main_thread_ = std::this_thread::get_id();
+
+    //! apply the commands recorded in the command buffers
+    void apply_commands();
+
+    //! remove an entity from the children of its parent, when its components::parent is destroyed
+    void unlink_from_parent(entt::registry &registry, entt::entity entity);
+
+    //! remove the parent of the children of an entity, when its components::children is destroyed
+    void orphan_children(entt::registry &registry, entt::entity entity);
+
+    //! let the next read of the tracked changes take the changes collected since the last one
+    void expire_changes();
+
+    //! the job system, declared last so it is stopped before anything else is destroyed
+    job_system jobs_;
+
     //! get the time since the epoch
     [[nodiscard]] static auto since_epoch() -> float;
 
@@ -624,22 +1496,6 @@ private:
     //! helper to remove all systems from a vector of systems
     void remove_all_systems_from_vector(systems_vector &systems) noexcept;
 
-    //! helper to recursively create components
-    template<typename... Args>
-    void recurse_create(entt::entity entity_id, Args... args) {
-        helper_create_shift(entity_id, args...);
-    }
-
-    //! helper to recursively create components, add one component and shift the arguments
-    template<typename Type, typename... Args>
-    [[maybe_unused]] void helper_create_shift(entt::entity entity_id, Type value, Args &&...args) {
-        set_component<Type>(entity_id, value);
-        recurse_create(entity_id, args...);
-    }
-
-    //! helper to recursively create components, for the last component
-    void helper_create_shift(entt::entity) {} // NOLINT(readability-named-parameter)
-
     //! sorting function by priority
     static auto sort_by_priority(const system_ptr &lhs, const system_ptr &rhs) noexcept -> bool;
 };
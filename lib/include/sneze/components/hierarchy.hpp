@@ -0,0 +1,82 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <entt/fwd.hpp>
+
+#include "geometry.hpp"
+
+namespace sneze::components {
+
+/**
+ * @brief component to hold the parent of an entity in a hierarchy
+ *
+ * the position, scale and rotation of an entity with a parent are relative to its parent.
+ *
+ * @note use world::set_parent and world::remove_parent to change the hierarchy
+ */
+struct parent {
+    //! the parent entity
+    entt::entity entity; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief component to hold the children of an entity in a hierarchy
+ * @note use world::set_parent and world::remove_parent to change the hierarchy
+ */
+struct children {
+    //! the children entities
+    std::vector<entt::entity> entities{}; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief component to hold the local scale and rotation of an entity in a hierarchy
+ *
+ * they are applied to the children of the entity, and to the entity itself if it is a sprite.
+ */
+struct transform {
+    //! the scale
+    float scale{1.0F}; // cppcheck-suppress unusedStructMember
+    //! the rotation, in degrees
+    float rotation{0.0F}; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief component to hold the transform of an entity in a hierarchy in logical coordinates, calculated by the
+ * transform system from the parent
+ * @see sneze::transform_system
+ */
+struct world_transform {
+    //! the position in logical coordinates
+    components::position position{0.0F, 0.0F}; // cppcheck-suppress unusedStructMember
+    //! the scale
+    float scale{1.0F}; // cppcheck-suppress unusedStructMember
+    //! the rotation, in degrees
+    float rotation{0.0F}; // cppcheck-suppress unusedStructMember
+};
+
+} // namespace sneze::components
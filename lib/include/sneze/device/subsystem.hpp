@@ -0,0 +1,68 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cinttypes>
+#include <string>
+
+//! @brief device namespace
+namespace sneze::device {
+
+//! @brief a set of subsystems, combined with |
+using subsystems = uint32_t;
+
+/**
+ * @brief subsystem class
+ *
+ * the subsystems that sneze could initialize besides video and events, that are always initialized.
+ *
+ * @see config::subsystems
+ * @see application::require_subsystems
+ */
+class subsystem {
+public:
+    //! no subsystem
+    [[maybe_unused]] static const subsystems none;
+    //! audio subsystem
+    [[maybe_unused]] static const subsystems audio;
+    //! joystick subsystem
+    [[maybe_unused]] static const subsystems joystick;
+    //! haptic (force feedback) subsystem
+    [[maybe_unused]] static const subsystems haptic;
+    //! game controller subsystem, it brings up the joystick subsystem
+    [[maybe_unused]] static const subsystems game_controller;
+    //! sensor subsystem
+    [[maybe_unused]] static const subsystems sensor;
+
+    /**
+     * @brief Get the string representation of a set of subsystems.
+     *
+     * @param value The subsystems.
+     * @return The string representation of the subsystems.
+     */
+    static auto string(const subsystems &value) -> std::string;
+};
+
+} // namespace sneze::device
@@ -23,6 +23,7 @@ SOFTWARE.
 ****************************************************************************/
 
 #pragma once
+#include "../globals/globals.hpp"
 #include "../systems/system.hpp"
 
 namespace sneze {
@@ -51,6 +52,16 @@ public:
      * @param world the world that owns this system
      */
     void update(world *world) override;
+
+    /**
+     * @brief get the access of the system, it reads the game time and writes the effects and colors
+     * @return the access of the system
+     */
+    [[nodiscard]] auto access() const -> system_access override;
+
+private:
+    //! the game time global, kept across updates
+    const game_time *time_{nullptr};
 };
 
 } // namespace sneze
\ No newline at end of file
@@ -24,7 +24,12 @@ SOFTWARE.
 
 #pragma once
 
-//! embedded namespace
+/**
+ * @brief embedded namespace
+ *
+ * embedded resources are compiled into the library, they are loaded on first use, for example when the first label
+ * using embedded::mono_font is drawn, or could be loaded ahead with application::preload.
+ */
 namespace sneze::embedded {
 
 //! embedded sneze logo, in png format
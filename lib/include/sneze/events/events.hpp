@@ -25,6 +25,7 @@ SOFTWARE.
 #pragma once
 
 #include <cinttypes>
+#include <cstddef>
 #include <cstdint>
 
 #include <entt/fwd.hpp>
@@ -51,6 +52,21 @@ struct application_want_closing: public event {};
 //! event that indicates that we want to toggle fullscreen.
 struct toggle_fullscreen: public event {};
 
+//! event that indicates that we want to toggle the profiler overlay.
+struct toggle_profiler_overlay: public event {};
+
+//! event that indicates that we want to dump the trace.
+struct dump_trace: public event {};
+
+/**
+ * @brief event that indicates that we want to capture the next frames into image files.
+ * @see config::capture
+ */
+struct capture: public event {
+    //! the number of frames to capture, 0 to capture the frames set in the config.
+    std::size_t frames = 0; // cppcheck-suppress unusedStructMember
+};
+
 //! key base event.
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
 struct key_event: public event, public keyboard::key_modifier {};
@@ -74,6 +90,7 @@ struct window_resized: public event {
 
 /**
  * @brief event that indicates that we want to add a component to an entity.
+ * @note the event has a copy of the component, world::add_component_listener gives a reference instead.
  * @tparam ComponentType the type of the component to add.
  */
 template<typename ComponentType>
@@ -84,10 +101,22 @@ struct add_component: public event {
     ComponentType component;
 };
 
+//! the moments on the life of a component that could be listened.
+enum class lifecycle {
+    //! the component was added to an entity.
+    construct,
+    //! the component of an entity was updated.
+    update,
+    //! the component is going to be removed from an entity.
+    destroy
+};
+
 //! mouse moved event.
 struct mouse_moved: public event {
     //! the new position of the mouse.
     components::position point; // cppcheck-suppress unusedStructMember
+    //! the movement of the mouse since the previous event, accumulated if the input is coalesced.
+    components::position delta; // cppcheck-suppress unusedStructMember
 };
 
 //! mouse button base event.
@@ -104,6 +133,18 @@ struct mouse_button_down: public mouse_button {};
 //! mouse button up event.
 struct mouse_button_up: public mouse_button {};
 
+/**
+ * @brief event that indicates the progress of a preload.
+ * @note this event is triggered immediately, during the preload, not at the end of the update.
+ * @see application::preload
+ */
+struct preload_progress: public event {
+    //! the number of steps done.
+    std::size_t done; // cppcheck-suppress unusedStructMember
+    //! the total number of steps.
+    std::size_t total; // cppcheck-suppress unusedStructMember
+};
+
 } // namespace events
 
 } // namespace sneze
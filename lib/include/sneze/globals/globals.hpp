@@ -24,6 +24,12 @@ SOFTWARE.
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
 namespace sneze {
 
 //! game time global
@@ -34,4 +40,116 @@ struct game_time {
     float elapsed = 0.F; // cppcheck-suppress unusedStructMember
 };
 
-} // namespace sneze
\ No newline at end of file
+/**
+ * @brief input latency global
+ *
+ * measures the time, in milliseconds, from the oldest input event of a frame until it was handled by the listeners and
+ * until a frame with its result was presented.
+ *
+ * @see world::now
+ * @see config::immediate_input
+ */
+struct input_latency {
+    //! if there is input not presented yet
+    bool pending = false; // cppcheck-suppress unusedStructMember
+    //! world time of the oldest input event not presented yet
+    double event_time = 0.0; // cppcheck-suppress unusedStructMember
+    //! if the pending input was handled
+    bool is_handled = false; // cppcheck-suppress unusedStructMember
+    //! world time when the pending input was handled
+    double handled_time = 0.0; // cppcheck-suppress unusedStructMember
+    //! time from the input event until it was handled, of the last input presented
+    float handled = 0.F; // cppcheck-suppress unusedStructMember
+    //! time from the input event until it was presented, of the last input presented
+    float presented = 0.F; // cppcheck-suppress unusedStructMember
+};
+
+//! the statistics of a section of the frames, in milliseconds
+struct section_profile {
+    //! the name of the section
+    std::string name; // cppcheck-suppress unusedStructMember
+    //! the time on the last frame
+    float last = 0.F; // cppcheck-suppress unusedStructMember
+    //! the minimum time on the recent frames
+    float min = 0.F; // cppcheck-suppress unusedStructMember
+    //! the average time on the recent frames
+    float avg = 0.F; // cppcheck-suppress unusedStructMember
+    //! the 99th percentile of the time on the recent frames
+    float p99 = 0.F; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief frame profile global
+ *
+ * the statistics of the recent frames, updated at the end of each frame, with a section for each system, in update
+ * order, and a last section for the events dispatch.
+ *
+ * @see frame_profiler
+ */
+struct frame_profile {
+    //! the frames per second on the recent frames
+    float fps = 0.F; // cppcheck-suppress unusedStructMember
+    //! the average time of the recent frames, in milliseconds
+    float frame_time = 0.F; // cppcheck-suppress unusedStructMember
+    //! the time of each recent frame, in milliseconds, from the oldest to the newest
+    std::vector<float> frames; // cppcheck-suppress unusedStructMember
+    //! the statistics of each section of the frames
+    std::vector<section_profile> sections; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief counters of the submissions made to the renderer
+ * @tparam Type the type of the counters
+ */
+template<typename Type>
+struct render_counters {
+    //! calls that submit geometry: texture copies, geometry, lines and clears
+    Type draw_calls{}; // cppcheck-suppress unusedStructMember
+    //! vertices submitted, four for each texture copy and two for each line
+    Type vertices{}; // cppcheck-suppress unusedStructMember
+    //! draw calls using a different texture than the previous one
+    Type texture_switches{}; // cppcheck-suppress unusedStructMember
+    //! changes of draw color, texture color and texture alpha
+    Type state_changes{}; // cppcheck-suppress unusedStructMember
+    //! renderables skipped since they are not visible
+    Type culled{}; // cppcheck-suppress unusedStructMember
+    //! labels drawn
+    Type labels{}; // cppcheck-suppress unusedStructMember
+    //! glyphs drawn
+    Type glyphs{}; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief render statistics global
+ *
+ * the counters of the submissions made to the renderer on the last frame, and their averages on the recent frames,
+ * updated at the end of each frame.
+ *
+ * @see render::get_stats
+ */
+struct render_stats {
+    //! the counters of the last frame
+    render_counters<std::uint32_t> frame; // cppcheck-suppress unusedStructMember
+    //! the average of the counters on the recent frames
+    render_counters<float> average; // cppcheck-suppress unusedStructMember
+    //! the scale of the resolution that the last frame was rendered at
+    float resolution_scale = 1.F; // cppcheck-suppress unusedStructMember
+
+    /**
+     * @brief get the string representation of the averages
+     * @return the string representation of the averages
+     */
+    [[nodiscard]] auto string() const {
+        return fmt::format("draws: {:.1f} vertices: {:.1f} textures: {:.1f} states: {:.1f} culled: {:.1f} labels: "
+                           "{:.1f} glyphs: {:.1f}",
+                           average.draw_calls,
+                           average.vertices,
+                           average.texture_switches,
+                           average.state_changes,
+                           average.culled,
+                           average.labels,
+                           average.glyphs);
+    }
+};
+
+} // namespace sneze
@@ -0,0 +1,177 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace sneze {
+
+/**
+ * @brief a bounded lock-free queue for many producers and consumers
+ *
+ * the queue is a ring of cells, each cell have a sequence number that tells if it is ready to be written or read, so
+ * producers and consumers only compete on their own position with a compare and swap and never wait for each other.
+ *
+ * @note the capacity is rounded up to a power of two
+ * @tparam Type the type of the values in the queue
+ */
+template<typename Type>
+class bounded_queue {
+public:
+    /**
+     * @brief create a new queue
+     * @param capacity the maximum number of values in the queue, rounded up to a power of two
+     */
+    explicit bounded_queue(std::size_t capacity)
+        : capacity_{round_capacity(capacity)}, mask_{capacity_ - 1}, cells_{std::make_unique<cell[]>(capacity_)} {
+        for(std::size_t index = 0; index < capacity_; ++index) {
+            cells_[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    ~bounded_queue() = default;
+
+    bounded_queue(const bounded_queue &) = delete;
+    bounded_queue(bounded_queue &&) = delete;
+    auto operator=(const bounded_queue &) -> bounded_queue & = delete;
+    auto operator=(bounded_queue &&) -> bounded_queue & = delete;
+
+    /**
+     * @brief add a value to the queue
+     * @param value the value to add
+     * @return true if the value was added, false if the queue is full
+     */
+    [[nodiscard]] auto try_push(Type &&value) -> bool {
+        auto position = enqueue_position_.load(std::memory_order_relaxed);
+        cell *target = nullptr;
+        for(;;) {
+            target = &cells_[position & mask_];
+            const auto sequence = target->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if(difference == 0) {
+                if(enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if(difference < 0) {
+                return false;
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+        target->value.emplace(std::move(value));
+        target->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief take the oldest value from the queue
+     * @return the value, or nothing if the queue is empty
+     */
+    [[nodiscard]] auto try_pop() -> std::optional<Type> {
+        auto position = dequeue_position_.load(std::memory_order_relaxed);
+        cell *target = nullptr;
+        for(;;) {
+            target = &cells_[position & mask_];
+            const auto sequence = target->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if(difference == 0) {
+                if(dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if(difference < 0) {
+                return std::nullopt;
+            } else {
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+        auto result = std::optional<Type>{std::move(target->value)};
+        target->value.reset();
+        target->sequence.store(position + capacity_, std::memory_order_release);
+        return result;
+    }
+
+    /**
+     * @brief get the number of values in the queue
+     * @note with concurrent producers or consumers it is only an approximation
+     * @return the number of values
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        const auto dequeue = dequeue_position_.load(std::memory_order_relaxed);
+        const auto enqueue = enqueue_position_.load(std::memory_order_relaxed);
+        return enqueue > dequeue ? std::min(enqueue - dequeue, capacity_) : 0;
+    }
+
+    /**
+     * @brief get the maximum number of values in the queue
+     * @return the capacity of the queue
+     */
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t {
+        return capacity_;
+    }
+
+private:
+    //! a cell of the ring
+    struct cell {
+        //! the sequence that tells if the cell is ready to be written or read
+        std::atomic<std::size_t> sequence{0};
+        //! the value stored
+        std::optional<Type> value{};
+    };
+
+    //! size of a cache line, to avoid false sharing between producers and consumers
+    static constexpr std::size_t cache_line = 64;
+
+    //! round a capacity up to a power of two, at least 2
+    static constexpr auto round_capacity(std::size_t capacity) noexcept -> std::size_t {
+        auto result = std::size_t{2};
+        while(result < capacity) {
+            result <<= 1U;
+        }
+        return result;
+    }
+
+    //! the capacity of the queue
+    std::size_t capacity_;
+
+    //! mask to get the cell of a position
+    std::size_t mask_;
+
+    //! the cells of the ring
+    std::unique_ptr<cell[]> cells_; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+
+    //! the position of the next value to write
+    alignas(cache_line) std::atomic<std::size_t> enqueue_position_{0};
+
+    //! the position of the next value to read
+    alignas(cache_line) std::atomic<std::size_t> dequeue_position_{0};
+};
+
+} // namespace sneze
@@ -0,0 +1,210 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sneze {
+
+/**
+ * @brief a work stealing job system
+ *
+ * each worker thread have its own queue of jobs, a worker takes the last job that it added to its own queue and when its
+ * queue is empty it steals the oldest job from other queues. Threads that are not workers, like the main thread, share
+ * an extra queue.
+ *
+ * jobs are grouped using a job_system::counter, waiting on a counter runs pending jobs in the waiting thread until all
+ * the jobs of the counter are completed, so a job could start other jobs and wait for them.
+ *
+ * @code
+ * auto counter = job_system::counter{};
+ * jobs.run(counter, [&]() { update_physics(); });
+ * jobs.run(counter, [&]() { update_particles(); });
+ * jobs.wait(counter);
+ * @endcode
+ *
+ * if the job system is not started all jobs run in the thread that wait for them.
+ */
+class job_system {
+public:
+    //! a job to run
+    using job = std::function<void()>;
+
+    //! counter of pending jobs, used to wait for a group of jobs
+    class counter {
+    public:
+        /**
+         * @brief check if all the jobs of the counter are completed
+         * @return true if there is no pending jobs
+         */
+        [[nodiscard]] auto done() const noexcept -> bool {
+            return pending_.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class job_system;
+        //! number of pending jobs
+        std::atomic<std::size_t> pending_{0};
+    };
+
+    job_system() = default;
+
+    //! stop the job system
+    ~job_system();
+
+    job_system(const job_system &) = delete;
+    job_system(job_system &&) = delete;
+
+    auto operator=(const job_system &) -> job_system & = delete;
+    auto operator=(job_system &&) -> job_system & = delete;
+
+    /**
+     * @brief start the worker threads
+     * @param workers number of worker threads, 0 will use one less than the number of hardware threads, since the
+     * thread that waits for the jobs also runs them
+     */
+    void start(std::size_t workers = 0);
+
+    //! stop the worker threads, pending jobs are completed before stopping
+    void stop();
+
+    /**
+     * @brief run a job
+     * @param counter the counter to add the job to
+     * @param job the job to run
+     */
+    void run(counter &counter, job job);
+
+    /**
+     * @brief wait for all the jobs of a counter, running pending jobs while waiting
+     * @param counter the counter to wait for
+     */
+    void wait(const counter &counter);
+
+    /**
+     * @brief run one pending job in the calling thread
+     * @return true if a job was run, false if there was no pending jobs
+     */
+    auto run_pending() -> bool;
+
+    /**
+     * @brief run a function over a range of indexes in parallel
+     *
+     * the range is split in chunks, each chunk is a job that calls the function with the begin and end of the chunk,
+     * this function returns when all the chunks are completed.
+     *
+     * @tparam Function the type of the function, void(std::size_t begin, std::size_t end)
+     * @param count number of indexes
+     * @param chunk_size number of indexes on each chunk, at least 1
+     * @param function the function to run
+     */
+    template<typename Function>
+    void parallel_for(std::size_t count, std::size_t chunk_size, Function &&function) {
+        chunk_size = std::max<std::size_t>(chunk_size, 1);
+        if(count <= chunk_size) {
+            function(std::size_t{0}, count);
+            return;
+        }
+
+        auto chunks = counter{};
+        for(std::size_t begin = chunk_size; begin < count; begin += chunk_size) {
+            const auto end = std::min(begin + chunk_size, count);
+            run(chunks, [&function, begin, end]() { function(begin, end); });
+        }
+        // the calling thread works on the first chunk, and then helps with the rest
+        function(std::size_t{0}, chunk_size);
+        wait(chunks);
+    }
+
+    /**
+     * @brief get the number of threads that run jobs, the workers plus the thread that waits
+     * @return the number of threads
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return workers_.size() + 1;
+    }
+
+    /**
+     * @brief get the index of the worker running in the calling thread
+     * @return the worker index, 0 for threads that are not workers
+     */
+    [[nodiscard]] static auto current_worker() noexcept -> std::size_t;
+
+private:
+    //! a job and the counter that it belongs to
+    struct entry {
+        //! the job to run
+        job function; // cppcheck-suppress unusedStructMember
+        //! the counter of the job
+        counter *owner; // cppcheck-suppress unusedStructMember
+    };
+
+    //! a queue of jobs
+    struct queue {
+        //! mutex to protect the jobs
+        std::mutex mutex; // cppcheck-suppress unusedStructMember
+        //! the jobs, owner works at the back, thieves at the front
+        std::deque<entry> jobs; // cppcheck-suppress unusedStructMember
+    };
+
+    //! queues, 0 for the threads that are not workers and one for each worker
+    std::vector<std::unique_ptr<queue>> queues_{};
+    //! the worker threads
+    std::vector<std::thread> workers_{};
+    //! number of jobs in all the queues
+    std::atomic<std::size_t> queued_{0};
+    //! if the workers are stopping
+    bool stopping_{false};
+    //! mutex for sleeping workers
+    std::mutex sleep_mutex_{};
+    //! condition to wake up sleeping workers
+    std::condition_variable wake_up_{};
+
+    /**
+     * @brief take a job, from the queue of the worker or stealing from other queues
+     * @param worker the worker index
+     * @param found the job found
+     * @return true if a job was found
+     */
+    auto take(std::size_t worker, entry &found) -> bool;
+
+    /**
+     * @brief run jobs until the job system is stopped
+     * @param worker the worker index
+     */
+    void worker_loop(std::size_t worker);
+};
+
+} // namespace sneze
@@ -46,6 +46,27 @@ public:
      * @param span The span to read from
      */
     explicit span_stream_buffer(std::span<const std::byte> span);
+
+protected:
+    /**
+     * @brief Set the read position relative to the beginning, the current position or the end of the span
+     *
+     * @param offset The offset to move the read position
+     * @param direction The position to move from
+     * @param which The sequence to move, only input is supported
+     * @return the new read position, or -1 if the position is not valid
+     */
+    auto seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which)
+        -> pos_type override;
+
+    /**
+     * @brief Set the read position to an absolute position
+     *
+     * @param position The new read position
+     * @param which The sequence to move, only input is supported
+     * @return the new read position, or -1 if the position is not valid
+     */
+    auto seekpos(pos_type position, std::ios_base::openmode which) -> pos_type override;
 };
 } // namespace internal
 
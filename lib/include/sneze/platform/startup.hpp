@@ -0,0 +1,97 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "result.hpp"
+
+//! startup namespace, to measure the phases from the launch until the first frame is presented
+namespace sneze::startup {
+
+//! a phase of the startup
+struct phase {
+    //! the name of the phase
+    std::string name; // cppcheck-suppress unusedStructMember
+    //! the time that the phase started, since the startup began, in milliseconds
+    double start = 0.; // cppcheck-suppress unusedStructMember
+    //! the duration of the phase, in milliseconds
+    double duration = 0.; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief begin the startup, discarding any phase recorded
+ * @note the startup should be only measured from the main thread
+ */
+void begin();
+
+/**
+ * @brief record a phase, from the end of the previous phase until now
+ *
+ * the phase is also recorded on the trace, when sneze is built with SNEZE_ENABLE_TRACE.
+ *
+ * @param name the name of the phase
+ */
+void mark(std::string_view name);
+
+/**
+ * @brief get the phases recorded
+ * @return the phases, in the order that they were recorded
+ */
+[[nodiscard]] auto phases() -> const std::vector<phase> &;
+
+/**
+ * @brief get the time from the startup began until the end of the last phase
+ * @return the time in milliseconds
+ */
+[[nodiscard]] auto total() -> double;
+
+//! log the phases recorded and the total time of the startup
+void log();
+
+/**
+ * @brief write the phases recorded into a JSON file
+ * @param path the path of the file
+ * @return true if the file was written, error otherwise
+ */
+[[nodiscard]] auto dump(const std::filesystem::path &path) -> result<>;
+
+/**
+ * @brief get the file to write the startup report into
+ * @return the value of the environment variable SNEZE_STARTUP_REPORT, if it is set
+ */
+[[nodiscard]] auto report_file() -> std::optional<std::filesystem::path>;
+
+/**
+ * @brief check if the application should exit after presenting its first frame
+ * @return true if the environment variable SNEZE_EXIT_AFTER_FIRST_FRAME is set to anything but 0
+ */
+[[nodiscard]] auto exit_after_first_frame() -> bool;
+
+} // namespace sneze::startup
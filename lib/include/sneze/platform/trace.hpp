@@ -0,0 +1,134 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include "result.hpp"
+
+/**
+ * @def SNEZE_ZONE(name)
+ * @brief record the time of the current scope with a name, on the trace
+ *
+ * the zones are only recorded when sneze is built with the CMake option SNEZE_ENABLE_TRACE, otherwise this compiles to
+ * nothing.
+ *
+ * @code
+ * void my_game::load_level() {
+ *     SNEZE_ZONE("load_level");
+ *     // ...
+ * }
+ * @endcode
+ *
+ * @note the name must live until the trace is dumped, like a string literal or a name from sneze::trace::intern
+ * @see sneze::trace::dump
+ */
+#if defined(SNEZE_ENABLE_TRACE)
+#    define SNEZE_ZONE_CONCAT_IMPL(first, second) first##second
+#    define SNEZE_ZONE_CONCAT(first, second) SNEZE_ZONE_CONCAT_IMPL(first, second)
+#    define SNEZE_ZONE(name) const ::sneze::trace::zone SNEZE_ZONE_CONCAT(sneze_zone_, __LINE__)(name)
+#else
+#    define SNEZE_ZONE(name) static_cast<void>(0)
+#endif
+
+//! trace namespace, to record what happens inside the frames
+namespace sneze::trace {
+
+/**
+ * @brief check if the trace is enabled
+ * @return true if sneze was built with SNEZE_ENABLE_TRACE
+ */
+[[nodiscard]] constexpr auto enabled() -> bool {
+#if defined(SNEZE_ENABLE_TRACE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief get the time since the trace started
+ * @return the time in microseconds
+ */
+[[nodiscard]] auto now() -> double;
+
+/**
+ * @brief record a zone on the trace of the current thread
+ *
+ * each thread records into its own buffer without locks, when the buffer of a thread is full the oldest zones are
+ * overwritten, so a dump has the most recent zones.
+ *
+ * @param name the name of the zone
+ * @param start the time that the zone started, in microseconds
+ * @param end the time that the zone ended, in microseconds
+ */
+void record(const char *name, double start, double end);
+
+/**
+ * @brief get a name that lives until the end of the application, to use as the name of a zone
+ * @param name the name
+ * @return the name, the same pointer for equal names
+ */
+[[nodiscard]] auto intern(std::string_view name) -> const char *;
+
+/**
+ * @brief write all the zones recorded into a file, as Chrome trace event JSON
+ *
+ * the file could be opened with Perfetto or chrome://tracing.
+ *
+ * @param path the path of the file
+ * @return true if the file was written, error otherwise
+ */
+[[nodiscard]] auto dump(const std::filesystem::path &path) -> result<>;
+
+//! record the time of a scope on the trace, use it with SNEZE_ZONE
+class zone {
+public:
+    /**
+     * @brief start a zone
+     * @param name the name of the zone
+     */
+    explicit zone(const char *name) noexcept: name_{name}, start_{now()} {}
+
+    //! end the zone, recording it
+    ~zone() {
+        record(name_, start_, now());
+    }
+
+    zone(const zone &) = delete;
+    zone(zone &&) = delete;
+    auto operator=(const zone &) -> zone & = delete;
+    auto operator=(zone &&) -> zone & = delete;
+
+private:
+    //! the name of the zone
+    const char *name_;
+
+    //! the time that the zone started
+    double start_;
+};
+
+} // namespace sneze::trace
@@ -0,0 +1,92 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+//! utf-8 helpers namespace
+namespace sneze::utf8 {
+
+//! codepoint returned when the input is not valid utf-8
+static constexpr char32_t replacement = 0xFFFD;
+
+//! max valid unicode codepoint
+static constexpr char32_t max_codepoint = 0x10FFFF;
+
+/**
+ * @brief decode the next codepoint from an utf-8 string
+ *
+ * Decode the codepoint that starts at the given index and advance the index to the next codepoint. Single byte
+ * (ascii) characters are returned without any further decoding.
+ *
+ * @note invalid or truncated sequences are returned as utf8::replacement, consuming a single byte
+ *
+ * @param text the utf-8 text to decode
+ * @param index the index to decode from, will be advanced to the next codepoint
+ * @return the decoded codepoint
+ */
+[[nodiscard]] constexpr auto next(std::string_view text, std::size_t &index) noexcept -> char32_t {
+    const auto lead = static_cast<unsigned char>(text[index++]);
+    if(lead < 0x80U) [[likely]] {
+        return lead;
+    }
+
+    std::size_t length = 0;
+    char32_t codepoint = 0;
+    if((lead & 0xE0U) == 0xC0U) {
+        length = 1;
+        codepoint = lead & 0x1FU;
+    } else if((lead & 0xF0U) == 0xE0U) {
+        length = 2;
+        codepoint = lead & 0x0FU;
+    } else if((lead & 0xF8U) == 0xF0U) {
+        length = 3;
+        codepoint = lead & 0x07U;
+    } else {
+        return replacement;
+    }
+
+    if(index + length > text.size()) {
+        return replacement;
+    }
+
+    for(std::size_t i = 0; i < length; ++i) {
+        const auto continuation = static_cast<unsigned char>(text[index + i]);
+        if((continuation & 0xC0U) != 0x80U) {
+            return replacement;
+        }
+        codepoint = (codepoint << 6U) | (continuation & 0x3FU);
+    }
+    index += length;
+
+    if(codepoint > max_codepoint) {
+        return replacement;
+    }
+
+    return codepoint;
+}
+
+} // namespace sneze::utf8
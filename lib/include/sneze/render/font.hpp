@@ -25,6 +25,9 @@ SOFTWARE.
 #pragma once
 
 #include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -107,8 +110,19 @@ public:
      */
     void end() override;
 
+    /**
+     * @brief get the textures that a font file needs
+     * @details only the page lines of the font file are parsed, so the textures could be loaded ahead of the font
+     * @param render render to use
+     * @param file font file
+     * @return the paths of the font pages textures, error if the font file does not exist
+     */
+    [[nodiscard]] static auto dependencies(class render *render, const std::string &file)
+        -> result<std::vector<std::string>, error>;
+
     /**
      * @brief draw text
+     * @note text is decoded as utf-8, glyphs not present in the font are skipped
      * @param text text to draw
      * @param position position of the text
      * @param alignment alignment of the text
@@ -123,6 +137,7 @@ public:
 
     /**
      * @brief get the size of the text
+     * @note text is decoded as utf-8, glyphs not present in the font are skipped
      * @param text text to get the size
      * @param size font size of the text
      * @return size of the text
@@ -132,23 +147,40 @@ public:
 private:
     //! max number of page textures
     static constexpr auto max_pages = 16;
+    //! number of codepoints covered by a glyph block
+    static constexpr std::size_t glyph_block_size = 256;
     //! params type for the tokens
     using params = std::unordered_map<std::string, std::string>;
-    //! glyphs type
-    using glyphs = std::array<glyph, 256>;
+    //! glyph block type, the glyphs for a range of glyph_block_size codepoints
+    using glyph_block = std::array<glyph, glyph_block_size>;
+    //! extended glyphs type, glyph blocks indexed by codepoint / glyph_block_size, allocated on demand
+    using extended_glyphs = std::vector<std::unique_ptr<glyph_block>>;
     //! pages type
     using pages = std::array<std::string, max_pages>;
-    //! kernings type
-    using kernings = std::array<std::array<int, 256>, 256>;
+
+    //! kerning amount for a pair of codepoints
+    struct kerning {
+        //! the pair of codepoints, first codepoint in the high bits
+        std::uint64_t pair; // cppcheck-suppress unusedStructMember
+        //! the kerning amount
+        float amount; // cppcheck-suppress unusedStructMember
+    };
+
+    //! kernings type, sorted by pair once the font is loaded
+    using kernings = std::vector<kerning>;
 
     //! font name
     std::string face_{};
     //! font directory
     std::filesystem::path font_directory_{};
-    //! font glyphs
-    glyphs glyphs_{};
+    //! glyphs for the first block of codepoints (ascii & latin-1), always present
+    glyph_block base_glyphs_{};
+    //! glyphs outside the first block of codepoints
+    extended_glyphs extended_glyphs_{};
     //! font kernings
     kernings kernings_{};
+    //! codepoints in the first block that start a kerning pair
+    std::bitset<glyph_block_size> base_kernings_{};
     //! line height
     int line_height_{0};
     //! font spacing
@@ -286,6 +318,43 @@ private:
      * @return true if the parsing was ok, false otherwise
      */
     [[nodiscard]] auto validate_parsing() -> bool;
+
+    /**
+     * @brief get the glyph for a codepoint
+     * @param codepoint the codepoint to get the glyph for
+     * @return the glyph or nullptr if the font does not have it
+     */
+    [[nodiscard]] inline auto get_glyph(char32_t codepoint) const noexcept -> const glyph * {
+        if(codepoint < glyph_block_size) [[likely]] {
+            return &base_glyphs_[codepoint];
+        }
+        const auto block = codepoint / glyph_block_size;
+        if(block < extended_glyphs_.size() && extended_glyphs_[block] != nullptr) {
+            return &(*extended_glyphs_[block])[codepoint % glyph_block_size];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief get the kerning between two codepoints
+     * @param first the first codepoint
+     * @param second the second codepoint
+     * @return the kerning amount, 0 if there is no kerning for the pair
+     */
+    [[nodiscard]] auto get_kerning(char32_t first, char32_t second) const noexcept -> float;
+
+    /**
+     * @brief get the kerning pair key for two codepoints
+     * @param first the first codepoint
+     * @param second the second codepoint
+     * @return the kerning pair key
+     */
+    [[nodiscard]] static constexpr auto kerning_pair(char32_t first, char32_t second) noexcept -> std::uint64_t {
+        return (static_cast<std::uint64_t>(first) << 32U) | static_cast<std::uint64_t>(second);
+    }
+
+    //! sort the kernings so they could be searched
+    void sort_kernings();
 };
 
 } // namespace sneze
@@ -0,0 +1,175 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+#include "../platform/bounded_queue.hpp"
+#include "../platform/result.hpp"
+
+#include "capture_format.hpp"
+
+struct SDL_Renderer;
+
+namespace sneze {
+
+/**
+ * @brief frame capture class
+ *
+ * capture frames into image files without stalling the frames: the pixels of a frame are read into a pooled buffer
+ * and a background thread encodes and writes them. when all the buffers are in use the frame is dropped, so capturing
+ * never blocks the frames.
+ *
+ * the files are named capture_[sequence]_[frame] in the capture folder, with a sequence for each request and the
+ * position of the frame in the request, so the frames dropped leave gaps in the names.
+ *
+ * @see render::capture
+ */
+class frame_capture {
+public:
+    //! maximum number of frames read and waiting to be written
+    static constexpr auto max_buffers = std::size_t{8};
+
+    frame_capture();
+    ~frame_capture();
+
+    frame_capture(const frame_capture &) = delete;
+    frame_capture(frame_capture &&) = delete;
+    auto operator=(const frame_capture &) -> frame_capture & = delete;
+    auto operator=(frame_capture &&) -> frame_capture & = delete;
+
+    /**
+     * @brief set where and how the frames are written
+     * @param folder the folder to write the files into
+     * @param format the image format of the files
+     */
+    void configure(const std::filesystem::path &folder, capture_format format);
+
+    /**
+     * @brief request to capture the next frames, as a new sequence
+     * @param frames the number of frames to capture
+     */
+    void request(std::size_t frames);
+
+    /**
+     * @brief check if the current frame should be captured
+     * @return true if there are frames requested not captured yet
+     */
+    [[nodiscard]] auto wants_frame() const noexcept -> bool {
+        return remaining_ != 0;
+    }
+
+    /**
+     * @brief read the pixels of the current frame and queue them to be written
+     * @note this should be called before presenting the frame
+     * @param renderer the SDL renderer
+     */
+    void grab(SDL_Renderer *renderer);
+
+    //! stop capturing, waiting until the frames queued are written
+    void stop();
+
+    /**
+     * @brief get the frames written
+     * @return the number of frames written
+     */
+    [[nodiscard]] auto captured() const noexcept -> std::size_t {
+        return captured_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief get the frames dropped since all the buffers were in use, or they could not be read or written
+     * @return the number of frames dropped
+     */
+    [[nodiscard]] auto dropped() const noexcept -> std::size_t {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    //! the pixels of a frame and where to write them
+    struct frame {
+        //! the pixels, in RGBA
+        std::vector<std::uint8_t> pixels; // cppcheck-suppress unusedStructMember
+        //! the width in pixels
+        int width = 0; // cppcheck-suppress unusedStructMember
+        //! the height in pixels
+        int height = 0; // cppcheck-suppress unusedStructMember
+        //! the image format
+        capture_format format = capture_format::png; // cppcheck-suppress unusedStructMember
+        //! the file to write
+        std::filesystem::path path; // cppcheck-suppress unusedStructMember
+    };
+
+    //! buffers ready to read a frame into
+    bounded_queue<std::unique_ptr<frame>> free_;
+    //! frames waiting to be written
+    bounded_queue<std::unique_ptr<frame>> pending_;
+    //! released once for each frame pending, and once to stop the writer
+    std::counting_semaphore<> ready_{0};
+    //! the thread that writes the frames
+    std::thread writer_;
+    //! the number of buffers allocated
+    std::size_t buffers_ = 0;
+    //! the folder to write the files into
+    std::filesystem::path folder_{"."};
+    //! the image format of the files
+    capture_format format_ = capture_format::png;
+    //! the frames requested on the current sequence
+    std::size_t requested_ = 0;
+    //! the frames requested not captured yet
+    std::size_t remaining_ = 0;
+    //! the current sequence
+    std::size_t sequence_ = 0;
+    //! the frames written
+    std::atomic<std::size_t> captured_{0};
+    //! the frames dropped
+    std::atomic<std::size_t> dropped_{0};
+
+    //! write the frames pending until stopped
+    void write_loop();
+
+    /**
+     * @brief encode a frame and write it into its file
+     * @param frame the frame
+     * @return true if the file was written, error otherwise
+     */
+    [[nodiscard]] static auto write(const frame &frame) -> result<>;
+
+    /**
+     * @brief encode a frame as QOI and write it into its file
+     * @param frame the frame
+     * @return true if the file was written, error otherwise
+     */
+    [[nodiscard]] static auto write_qoi(const frame &frame) -> result<>;
+};
+
+} // namespace sneze
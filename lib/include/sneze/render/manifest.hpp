@@ -0,0 +1,68 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace sneze {
+
+//! types of assets that could be in a manifest
+enum class asset_type {
+    //! a font, loaded with application::load_font
+    font,
+    //! a single texture sprite, loaded with application::load_sprite
+    sprite,
+    //! a sprite sheet, loaded with application::load_sprite_sheet
+    sprite_sheet
+};
+
+/**
+ * @brief an asset in a manifest
+ * @see manifest
+ */
+struct asset {
+    //! the type of the asset
+    asset_type type; // cppcheck-suppress unusedStructMember
+    //! the path of the asset
+    std::string path; // cppcheck-suppress unusedStructMember
+};
+
+/**
+ * @brief list of assets to be loaded together
+ *
+ * @code
+ * auto level = manifest{
+ *     {asset_type::font, "fonts/title.fnt"},
+ *     {asset_type::sprite_sheet, "sprites/level1.json"},
+ *     {asset_type::sprite, "sprites/background.png"},
+ * };
+ * @endcode
+ *
+ * @see application::preload
+ */
+using manifest = std::vector<asset>;
+
+} // namespace sneze
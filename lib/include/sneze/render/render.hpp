@@ -24,28 +24,60 @@ SOFTWARE.
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <istream>
 #include <memory>
+#include <optional>
 #include <span>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "../app/world.hpp"
 #include "../components/geometry.hpp"
 #include "../components/renderable.hpp"
 #include "../components/ui.hpp"
+#include "../device/subsystem.hpp"
+#include "../globals/globals.hpp"
 #include "../platform/result.hpp"
 
 #include "font.hpp"
+#include "frame_capture.hpp"
+#include "manifest.hpp"
 #include "sprite_sheet.hpp"
 #include "texture.hpp"
 
 struct SDL_Renderer;
 struct SDL_Window;
 struct SDL_RWops;
+struct SDL_Surface;
+struct SDL_Texture;
 
 namespace sneze {
 
+/**
+ * @brief render driver settings
+ *
+ * how the SDL render driver is chosen, and the result of the last probe, read and saved in the render section of the
+ * settings.
+ */
+struct render_driver {
+    //! if the drivers are probed to choose the fastest one
+    bool probe = false; // cppcheck-suppress unusedStructMember
+    //! the driver to use always, skipping the probe, empty to not force any driver
+    std::string forced; // cppcheck-suppress unusedStructMember
+    //! the fastest driver on the last probe
+    std::string probed; // cppcheck-suppress unusedStructMember
+    //! the SDL version on the last probe
+    std::string sdl_version; // cppcheck-suppress unusedStructMember
+    //! the display on the last probe
+    std::string display; // cppcheck-suppress unusedStructMember
+};
+
 /**
  * @brief render class
  *
@@ -57,6 +89,13 @@ namespace sneze {
  */
 class render {
 public:
+    /**
+     * @brief callback to report the progress of a preload
+     * @param done the number of steps done
+     * @param total the total number of steps
+     */
+    using progress_callback = std::function<void(std::size_t done, std::size_t total)>;
+
     //! Construct a new render object
     render(): fonts_{this}, textures_{this}, sprite_sheets_{this} {};
     ~render() = default;
@@ -76,6 +115,8 @@ public:
      * @param title title of the window
      * @param icon icon of the window, file path
      * @param color clear color
+     * @param subsystems SDL subsystems to initialize besides video and events
+     * @param driver how to choose the render driver, updated with the result of a new probe
      * @return true if the render was initialized correctly or error if not
      */
     [[nodiscard]] auto init(const components::size &size,
@@ -84,7 +125,41 @@ public:
                             const int &monitor,
                             const std::string &title,
                             const std::string &icon,
-                            const components::color &color) -> result<>;
+                            const components::color &color,
+                            const device::subsystems &subsystems,
+                            render_driver &driver) -> result<>;
+
+    /**
+     * @brief render the frames into a target texture, with a resolution scaled from the frame time
+     * @details the scale of the target is lowered when the frames take longer than the target frame time, and raised
+     * back when they take much less, the target is upscaled to the window at the end of each frame. at full scale the
+     * target has the pixels of the window, and it follows the window size
+     * @param target_fps the frames per second to keep
+     * @param min_scale the minimum scale of the resolution
+     * @return true if the dynamic resolution is enabled or error if the renderer can't render into textures
+     */
+    [[nodiscard]] auto enable_dynamic_resolution(float target_fps, float min_scale) -> result<>;
+
+    /**
+     * @brief set how the frames are captured
+     * @param folder the folder to write the captured frames into
+     * @param format the image format of the captured frames
+     * @param frames the frames to capture on each request
+     */
+    void configure_capture(const std::filesystem::path &folder, capture_format format, std::size_t frames);
+
+    /**
+     * @brief capture the next frames into image files, on a background thread
+     * @param frames the number of frames to capture, 0 to capture the frames set with configure_capture
+     */
+    void capture(std::size_t frames);
+
+    /**
+     * @brief initialize SDL subsystems that are not initialized yet
+     * @param subsystems the subsystems required
+     * @return true if the subsystems are initialized or error if not
+     */
+    [[nodiscard]] auto require_subsystems(const device::subsystems &subsystems) -> result<>;
 
     //! end the render
     void end();
@@ -117,6 +192,26 @@ public:
      */
     [[maybe_unused]] auto unload_font(const std::string &font_path) -> result<>;
 
+    /**
+     * @brief preload the assets of a manifest
+     *
+     * the textures needed by all the assets are found first, each texture is decoded only once and all of them are
+     * decoded in parallel, then the assets are loaded using the decoded textures.
+     *
+     * @param assets the assets to load
+     * @param jobs the job system used to decode the textures
+     * @param progress called on the calling thread each time a texture is decoded or an asset is loaded
+     * @return true if all the assets were loaded or error if not, then the assets loaded before the error are unloaded
+     */
+    [[nodiscard]] auto preload(const manifest &assets, job_system &jobs, const progress_callback &progress) -> result<>;
+
+    /**
+     * @brief unload the assets of a manifest
+     * @param assets the assets to unload
+     * @see render::preload
+     */
+    void unload(const manifest &assets);
+
     /**
      * @brief load a texture
      *
@@ -233,8 +328,24 @@ public:
      * @param sprite the sprite to draw
      * @param from the position to draw the sprite
      * @param color the color of the sprite
+     * @param scale scale to multiply the sprite scale, from its hierarchy
+     * @param rotation rotation to add to the sprite rotation, from its hierarchy
      */
-    void draw_sprite(components::sprite &sprite, const components::position &from, const components::color &color);
+    void draw_sprite(components::sprite &sprite,
+                     const components::position &from,
+                     const components::color &color,
+                     float scale = 1.0F,
+                     float rotation = 0.0F);
+
+    /**
+     * @brief get the index of a frame in a sprite sheet
+     * @param sprite_sheet_path path of the sprite sheet
+     * @param frame the frame name
+     * @return the index of the frame or error if the sprite sheet is not loaded or the frame does not exist
+     * @see sprite_sheet::frame_index
+     */
+    [[nodiscard]] auto get_frame_index(const std::string &sprite_sheet_path, const std::string &frame)
+        -> result<std::size_t, error>;
 
     /**
      * @brief get the window size
@@ -284,6 +395,39 @@ public:
         return renderer_;
     }
 
+    /**
+     * @brief get the render statistics
+     * @return the counters of the last frame ended and their averages on the recent frames
+     */
+    [[nodiscard]] auto get_stats() const noexcept -> const render_stats & {
+        return stats_;
+    }
+
+    /**
+     * @brief count a draw call submitted to SDL
+     * @param texture the texture drawn, nullptr for geometry without texture
+     * @param vertices the number of vertices submitted
+     */
+    void count_draw(const SDL_Texture *texture, std::uint32_t vertices) noexcept;
+
+    /**
+     * @brief count state changes submitted to SDL
+     * @param changes the number of state changes
+     */
+    void count_state_changes(std::uint32_t changes) noexcept {
+        counters_.state_changes += changes;
+    }
+
+    //! count a renderable skipped since it is not visible
+    void count_culled() noexcept {
+        counters_.culled++;
+    }
+
+    //! count a glyph drawn
+    void count_glyph() noexcept {
+        counters_.glyphs++;
+    }
+
     //! @brief toggle between fullscreen and windowed mode
     void toggle_fullscreen();
 
@@ -325,6 +469,7 @@ public:
 
     friend class font;
     friend class sprite_sheet;
+    friend class texture;
 
 protected:
     /**
@@ -334,6 +479,14 @@ protected:
      */
     [[nodiscard]] auto get_texture(const std::string &texture_path) -> std::shared_ptr<texture>;
 
+    /**
+     * @brief take a surface decoded by a preload
+     * @details the surface is removed from the decoded surfaces, and the caller owns it
+     * @param texture_path the path of the texture
+     * @return the decoded surface or nullptr if the texture was not decoded
+     */
+    [[nodiscard]] auto take_decoded_surface(const std::string &texture_path) -> SDL_Surface *;
+
 private:
     //! the font cache
     resources_cache<font> fonts_;
@@ -351,11 +504,105 @@ private:
     SDL_Renderer *renderer_ = {nullptr};
     //! embedded data map
     std::unordered_map<std::string, std::span<std::byte const>> embedded_data_;
+    //! embedded resources that failed to load on first use, so they are not loaded again every frame
+    std::unordered_set<std::string> failed_embedded_;
+    //! surfaces decoded by a preload waiting to be converted into textures
+    std::unordered_map<std::string, SDL_Surface *> decoded_surfaces_;
+    //! how many frames are used for the render statistics averages
+    static constexpr auto stats_frames = std::size_t{60};
+    //! the render counters of the current frame
+    render_counters<std::uint32_t> counters_ = {};
+    //! the render counters of the recent frames
+    std::array<render_counters<std::uint32_t>, stats_frames> counters_history_ = {};
+    //! the sum of the render counters of the recent frames
+    render_counters<std::uint64_t> counters_sum_ = {};
+    //! the next position to write in the counters history
+    std::size_t counters_index_ = 0;
+    //! how many frames are in the counters history
+    std::size_t counters_frames_ = 0;
+    //! the texture used by the last draw call
+    const SDL_Texture *last_texture_ = {nullptr};
+    //! the render statistics of the last frame ended
+    render_stats stats_ = {};
+    //! the logical size
+    components::size logical_ = {};
+    //! the target texture of the frames with dynamic resolution, nullptr when it is disabled
+    SDL_Texture *scene_ = {nullptr};
+    //! the scale of the resolution of the scene texture, relative to the resolution of the window
+    float scene_scale_ = 1.F;
+    //! the pixels of the scene texture for each logical unit
+    float scene_resolution_ = 1.F;
+    //! the width of the renderer output when the scene texture was created, in pixels
+    int scene_output_width_ = 0;
+    //! the height of the renderer output when the scene texture was created, in pixels
+    int scene_output_height_ = 0;
+    //! the minimum scale of the resolution of the scene texture
+    float min_scene_scale_ = 1.F;
+    //! the target frame time with dynamic resolution, in milliseconds
+    float target_frame_time_ = 0.F;
+    //! consecutive frames that took longer than the target frame time
+    int slow_frames_ = 0;
+    //! consecutive frames that took much less than the target frame time
+    int fast_frames_ = 0;
+    //! when the last frame was presented
+    std::chrono::steady_clock::time_point presented_ = {};
+    //! the frame capture
+    frame_capture capture_;
+    //! the frames to capture on each request
+    std::size_t capture_frames_ = 1;
+
+    /**
+     * @brief decode a texture file into a surface
+     * @note this could be called from any thread
+     * @param texture_path the path of the texture
+     * @return the decoded surface or nullptr if the texture could not be decoded
+     */
+    [[nodiscard]] auto decode_surface(const std::string &texture_path) -> SDL_Surface *;
+
+    //! free the decoded surfaces that were not converted into textures
+    void release_decoded_surfaces();
+
+    //! add the counters of the frame to the render statistics
+    void update_stats() noexcept;
+
+    /**
+     * @brief create the scene texture, with the size of the logical area on the renderer output scaled by the scene
+     * scale
+     * @return true if the texture was created, error otherwise
+     */
+    [[nodiscard]] auto create_scene() -> result<>;
+
+    /**
+     * @brief change the scene scale when the frame time stays away from the target frame time
+     * @param frame_time the time to render the last frame, without waiting to present it, in milliseconds
+     */
+    void adjust_scene_scale(float frame_time);
+
+    /**
+     * @brief check if an asset is already loaded
+     * @param asset the asset to check
+     * @return true if the asset is loaded, false otherwise
+     */
+    [[nodiscard]] auto is_loaded(const asset &asset) const -> bool;
+
+    /**
+     * @brief get the textures that an asset needs
+     * @param asset the asset
+     * @return the paths of the textures, error if the asset can't be read
+     */
+    [[nodiscard]] auto get_dependencies(const asset &asset) -> result<std::vector<std::string>, error>;
+
+    /**
+     * @brief load an asset
+     * @param asset the asset to load
+     * @return true if the asset was loaded or error if not
+     */
+    [[nodiscard]] auto load_asset(const asset &asset) -> result<>;
 
     /**
      * @brief get a font
      * @param font_path the path of the font
-     * @note this support embedded files
+     * @note this support embedded files, embedded fonts are loaded on first use if they are not loaded
      * @return a shared pointer to the font
      */
     [[nodiscard]] auto get_font(const std::string &font_path) -> std::shared_ptr<font>;
@@ -363,12 +610,22 @@ private:
     /**
      * @brief get a sprite sheet
      * @param sprite_sheet_path the path of the sprite sheet
-     * @param load_textures if the textures should be loaded
-     * @note this support embedded files
+     * @note this support embedded files, embedded sprites are loaded on first use if they are not loaded
      * @return a shared pointer to the sprite sheet
      */
     [[nodiscard]] auto get_sprite_sheet(const std::string &sprite_sheet_path) -> std::shared_ptr<sprite_sheet>;
 
+    /**
+     * @brief check if a path is an embedded resource that is not loaded
+     * @param path the path of the resource
+     * @param cache the cache where the resource should be
+     * @return true if the resource is embedded and is not in the cache
+     */
+    template<typename Cache>
+    [[nodiscard]] auto is_embedded_not_loaded(const std::string &path, const Cache &cache) const -> bool {
+        return !cache.contains(path) && embedded_data_.contains(path);
+    }
+
     /**
      * @brief get the preferred SDL driver
      * @note this is used to get the best driver for the current platform, the current priority is:
@@ -383,6 +640,36 @@ private:
      */
     [[nodiscard]] static auto preferred_driver() -> int;
 
+    /**
+     * @brief find a SDL driver by name
+     * @param name the name of the driver
+     * @return the SDL driver or nothing if it is not available
+     */
+    [[nodiscard]] static auto find_driver(const std::string &name) -> std::optional<int>;
+
+    /**
+     * @brief choose the SDL driver to create the renderer with
+     * @details a forced driver is used first, then the probed driver, probing again if the SDL version or the display
+     * changed, and last the preferred driver
+     * @param driver how to choose the render driver, updated with the result of a new probe
+     * @param monitor the monitor of the window
+     * @return the SDL driver
+     */
+    [[nodiscard]] static auto choose_driver(render_driver &driver, int monitor) -> int;
+
+    /**
+     * @brief time a synthetic batch on each SDL driver available
+     * @return the name of the fastest driver, empty if none could be probed
+     */
+    [[nodiscard]] static auto probe_drivers() -> std::string;
+
+    /**
+     * @brief time a synthetic batch on a SDL driver, into a hidden window
+     * @param driver_id the SDL driver
+     * @return the time in milliseconds, error if the driver can't render
+     */
+    [[nodiscard]] static auto probe_driver(int driver_id) -> result<float, error>;
+
     /**
      * @brief fill a vector of points with triangles
      * @param points a vector of points
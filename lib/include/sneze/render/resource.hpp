@@ -30,6 +30,7 @@ SOFTWARE.
 
 #include "../platform/logger.hpp"
 #include "../platform/result.hpp"
+#include "../platform/trace.hpp"
 #include "../platform/type_name.hpp"
 
 namespace sneze {
@@ -133,6 +134,7 @@ public:
      * @return true if the resource was loaded successfully, error otherwise
      */
     [[nodiscard]] auto load(const std::string &uri, Args... args) -> result<> {
+        SNEZE_ZONE("resources_cache::load");
         if(auto it_resource = resources_.find(uri); it_resource != resources_.end()) {
             it_resource->second.count++;
             logger::trace("request to load resource<{}>: {}, increase count to: {}",
@@ -189,6 +191,15 @@ public:
         return error("Fail to get resource.");
     }
 
+    /**
+     * @brief Check if a resource is loaded
+     * @param uri The URI of the resource
+     * @return true if the resource is loaded, false otherwise
+     */
+    [[nodiscard]] auto contains(const std::string &uri) const -> bool {
+        return resources_.contains(uri);
+    }
+
     /**
      * @brief Clear the cache
      */
@@ -24,10 +24,12 @@ SOFTWARE.
 
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "../components/geometry.hpp"
 
@@ -39,13 +41,21 @@ class render;
 
 /**
  * @brief sprite_sheet frame
+ * @details frames could be trimmed, removing the transparent borders of the original sprite, and stored rotated
+ * 90 degrees clockwise in the texture
  * @see sprite_sheet
  */
 struct frame {
-    //! frame rect
+    //! frame rect in the texture, for rotated frames the size is the size before the rotation
     components::rect rect; // cppcheck-suppress unusedStructMember
-    //! frame pivot
+    //! frame pivot, relative to the source size
     components::position pivot; // cppcheck-suppress unusedStructMember
+    //! size of the original sprite before trimming
+    components::size source_size{0, 0}; // cppcheck-suppress unusedStructMember
+    //! offset of the trimmed frame inside the original sprite
+    components::position source_offset{0, 0}; // cppcheck-suppress unusedStructMember
+    //! if the frame is stored rotated 90 degrees clockwise in the texture
+    bool rotated{false}; // cppcheck-suppress unusedStructMember
 };
 
 /**
@@ -83,6 +93,33 @@ public:
      */
     void end() override;
 
+    /**
+     * @brief get the textures that a sprite_sheet needs
+     * @details only the meta data of the json file is used, so the texture could be loaded ahead of the sprite_sheet
+     * @param render the render to use
+     * @param uri the uri to the json file or the texture
+     * @param is_single_texture if the sprite_sheet is a single texture
+     * @return the paths of the textures, error if the sprite_sheet can't be read
+     */
+    [[nodiscard]] static auto dependencies(class render *render, const std::string &uri, bool is_single_texture)
+        -> result<std::vector<std::string>, error>;
+
+    /**
+     * @brief get the index of a frame
+     * @details frames could be draw by index, avoiding to look up the frame name each time that is drawn
+     * @param name the frame name
+     * @return the index of the frame, error if the frame does not exist
+     */
+    [[nodiscard]] auto frame_index(const std::string &name) const -> result<std::size_t, error>;
+
+    /**
+     * @brief get the number of frames in the sprite_sheet
+     * @return the number of frames
+     */
+    [[nodiscard]] auto frame_count() const noexcept -> std::size_t {
+        return frames_.size();
+    }
+
     /**
      * @brief draw a sprite
      * @param name the frame name
@@ -101,9 +138,30 @@ public:
                      const float &scale,
                      const components::color &color) const;
 
+    /**
+     * @brief draw a sprite
+     * @param index the frame index
+     * @param position position to draw the sprite
+     * @param flip_x if the sprite should be flipped in the x axis
+     * @param flip_y if the sprite should be flipped in the y axis
+     * @param rotation rotation of the sprite
+     * @param scale scale of the sprite
+     * @param color tint of the sprite, color::white = no tint
+     * @see sprite_sheet::frame_index
+     */
+    void draw_sprite(const std::size_t &index,
+                     const components::position &position,
+                     const bool &flip_x,
+                     const bool &flip_y,
+                     const float &rotation,
+                     const float &scale,
+                     const components::color &color) const;
+
 private:
     //! the frames of the sprite_sheet
-    std::unordered_map<std::string, frame> frames_ = {};
+    std::vector<frame> frames_ = {};
+    //! the index of each frame by name
+    std::unordered_map<std::string, std::size_t> frame_indexes_ = {};
     //! the texture of the sprite_sheet
     std::string texture_;
     //! the sprite_sheet directory
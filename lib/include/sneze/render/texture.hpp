@@ -94,6 +94,24 @@ public:
               float rotation,
               components::color color);
 
+    /**
+     * @brief Draw the texture
+     * @param origin The origin rectangle
+     * @param destination The destination rectangle
+     * @param flip_x Flip the texture in the x axis
+     * @param flip_y Flip the texture in the y axis
+     * @param rotation The rotation of the texture
+     * @param center The rotation center, relative to the destination rectangle
+     * @param color The color to tint the texture, white = no tint
+     */
+    void draw(components::rect origin,
+              components::rect destination,
+              const bool &flip_x,
+              const bool &flip_y,
+              float rotation,
+              components::position center,
+              components::color color);
+
     /**
      * @brief Get the size of the texture
      * @return the size of the texture
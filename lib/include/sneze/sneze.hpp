@@ -32,33 +32,50 @@ SOFTWARE.
 namespace sneze {}
 
 #include "app/application.hpp"
+#include "app/command_buffer.hpp"
 #include "app/config.hpp"
+#include "app/event_channel.hpp"
+#include "app/frame_profiler.hpp"
 #include "app/settings.hpp"
 #include "app/world.hpp"
 #include "components/generic.hpp"
 #include "components/geometry.hpp"
+#include "components/hierarchy.hpp"
 #include "components/renderable.hpp"
 #include "components/ui.hpp"
 #include "device/keyboard.hpp"
 #include "device/mouse.hpp"
+#include "device/subsystem.hpp"
 #include "effects/effects.hpp"
 #include "effects/effects_system.hpp"
 #include "embedded/embedded.hpp"
 #include "events/events.hpp"
 #include "globals/globals.hpp"
+#include "platform/bounded_queue.hpp"
 #include "platform/error.hpp"
+#include "platform/job_system.hpp"
 #include "platform/logger.hpp"
 #include "platform/result.hpp"
 #include "platform/span_istream.hpp"
+#include "platform/startup.hpp"
+#include "platform/trace.hpp"
 #include "platform/type_name.hpp"
+#include "platform/utf8.hpp"
 #include "platform/version.hpp"
+#include "render/capture_format.hpp"
 #include "render/font.hpp"
+#include "render/frame_capture.hpp"
+#include "render/manifest.hpp"
 #include "render/render.hpp"
 #include "render/resource.hpp"
 #include "render/sprite_sheet.hpp"
 #include "render/texture.hpp"
 #include "systems/keys_system.hpp"
 #include "systems/layout_system.hpp"
+#include "systems/profiler_overlay_system.hpp"
 #include "systems/render_system.hpp"
 #include "systems/sdl_events_system.hpp"
 #include "systems/system.hpp"
+#include "systems/system_access.hpp"
+#include "systems/system_scheduler.hpp"
+#include "systems/transform_system.hpp"
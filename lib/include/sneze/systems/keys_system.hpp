@@ -41,9 +41,17 @@ public:
      * @brief Construct a new keys system object
      * @param exit the key modifier to exit the game
      * @param toggle_fullscreen the key modifier to toggle fullscreen
+     * @param toggle_profiler_overlay the key modifier to toggle the profiler overlay
+     * @param dump_trace the key modifier to dump the trace
+     * @param capture the key modifier to capture frames
      */
-    keys_system(const keyboard::key_modifier &exit, const keyboard::key_modifier &toggle_fullscreen)
-        : exit_(exit), toggle_full_screen_(toggle_fullscreen) {}
+    keys_system(const keyboard::key_modifier &exit,
+                const keyboard::key_modifier &toggle_fullscreen,
+                const keyboard::key_modifier &toggle_profiler_overlay,
+                const keyboard::key_modifier &dump_trace,
+                const keyboard::key_modifier &capture)
+        : exit_(exit), toggle_full_screen_(toggle_fullscreen), toggle_profiler_overlay_(toggle_profiler_overlay),
+          dump_trace_(dump_trace), capture_(capture) {}
 
     /**
      * @brief initialize the system
@@ -63,6 +71,12 @@ public:
      */
     void update(world *world) override;
 
+    /**
+     * @brief get the access of the system, it works on events, so its update does not read or write anything
+     * @return the access of the system
+     */
+    [[nodiscard]] auto access() const -> system_access override;
+
 private:
     //! handle the key up event
     void key_up(const events::key_up &event);
@@ -72,6 +86,15 @@ private:
 
     //! toggle fullscreen key and modifier
     keyboard::key_modifier toggle_full_screen_;
+
+    //! toggle profiler overlay key and modifier
+    keyboard::key_modifier toggle_profiler_overlay_;
+
+    //! dump trace key and modifier
+    keyboard::key_modifier dump_trace_;
+
+    //! capture key and modifier
+    keyboard::key_modifier capture_;
 };
 
 } // namespace sneze
\ No newline at end of file
@@ -24,6 +24,9 @@ SOFTWARE.
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "../components/ui.hpp"
 #include "../events/events.hpp"
 
@@ -36,7 +39,11 @@ namespace sneze {
  *
  * this system will handle the layout of elements in the screen
  *
+ * the layout is calculated only for the entities that get an anchor, or that their anchor or position is marked as
+ * changed, and for all the anchored entities when the window is resized, at most once per frame.
+ *
  * @note this system will only work with entities that have the anchor component
+ * @note modify the position of an anchored entity with world::patch, or use world::mark_changed, to update its layout
  * @see components::anchor
  */
 class layout_system: public system {
@@ -59,16 +66,28 @@ public:
      */
     void update(world *world) override;
 
+    /**
+     * @brief get the access of the system, it runs on the main thread since it may add positions and layouts
+     * @return the access of the system
+     */
+    [[nodiscard]] auto access() const -> system_access override;
+
 private:
     //! logical size of the screen
     components::rect logical_ = {{0, 0}, {0, 0}};
 
+    //! if the window was resized since the last update
+    bool resized_ = false;
+
+    //! changes of anchors and positions since the last update
+    std::unique_ptr<entt::observer> changes_{};
+
+    //! entities to layout on the current update
+    std::vector<entt::entity> pending_{};
+
     //! window resized event handler
     void window_resized(const events::window_resized &event);
 
-    //! add component anchor event handler
-    void add_component_anchor(events::add_component<components::anchor> const &event);
-
     //! calculate the layout of the entity
     void calculate_layout(world *world, entt::entity entity, const components::anchor &anchor) const;
 };
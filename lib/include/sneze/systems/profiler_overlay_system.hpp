@@ -0,0 +1,128 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__clang__)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+#include <entt/entt.hpp>
+#if defined(__clang__)
+#    pragma clang diagnostic pop
+#endif
+
+#include "../events/events.hpp"
+#include "../globals/globals.hpp"
+#include "system.hpp"
+
+namespace sneze {
+
+class render;
+
+/**
+ * @brief profiler overlay system
+ *
+ * system that shows on top of the game the sneze::frame_profile global, the FPS, the statistics of each system and a
+ * graph of the recent frames, using the embedded mono font. It is toggled with the key set on
+ * config::toggle_profiler_overlay.
+ */
+class profiler_overlay_system final: public system {
+public:
+    /**
+     * @brief Construct a new profiler overlay system object
+     * @param render the render object, to load the font
+     */
+    explicit profiler_overlay_system(std::shared_ptr<render> render);
+
+    /**
+     * @brief initialize the system
+     * @param world the world that owns this system
+     */
+    void init(world *world) override;
+
+    /**
+     * @brief shutdown the system
+     * @param world the world that owns this system
+     */
+    void end(world *world) override;
+
+    /**
+     * @brief update the system
+     * @param world the world that owns this system
+     */
+    void update(world *world) override;
+
+    /**
+     * @brief get the access of the system, it creates entities on update so it is exclusive
+     * @return the access of the system
+     */
+    [[nodiscard]] auto access() const -> system_access override;
+
+private:
+    //! the render object
+    std::shared_ptr<render> render_;
+
+    //! if the font is loaded
+    bool font_loaded_{false};
+
+    //! if the overlay is visible
+    bool visible_{false};
+
+    //! the background of the overlay
+    entt::entity background_{entt::null};
+
+    //! the labels, one for each line of text
+    std::vector<entt::entity> labels_;
+
+    //! the bars of the frames graph, one for each recent frame
+    std::vector<entt::entity> bars_;
+
+    //! the text of the lines of the overlay
+    std::vector<std::string> lines_;
+
+    //! toggle profiler overlay event handler
+    void toggle(const events::toggle_profiler_overlay &event);
+
+    //! show the overlay
+    void show(world *world);
+
+    //! hide the overlay
+    void hide(world *world);
+
+    //! write the lines of text of a profile and the render statistics
+    void write_lines(const frame_profile &profile, const render_stats &stats);
+
+    //! update the labels with the lines of text
+    void update_labels(world *world);
+
+    //! update the graph with the recent frames
+    void update_graph(world *world, const frame_profile &profile, float top);
+};
+
+} // namespace sneze
@@ -69,10 +69,19 @@ public:
      */
     void update(world *world) override;
 
+    /**
+     * @brief get the access of the system, it renders using SDL so it is exclusive and runs on the main thread
+     * @return the access of the system
+     */
+    [[nodiscard]] auto access() const -> system_access override;
+
 private:
     //! the render object
     std::shared_ptr<render> render_;
 
+    //! draw the renderables
+    void draw(world *world);
+
     //! sort renderables by depth
     static inline auto sort_by_depth(const components::renderable &lhs, const components::renderable &rhs) {
         if(lhs.depth == rhs.depth) {
@@ -83,6 +92,9 @@ private:
 
     //! toggle fullscreen event handler
     void toggle_fullscreen(events::toggle_fullscreen const &event) noexcept;
+
+    //! capture event handler
+    void capture(events::capture const &event);
 };
 
 } // namespace sneze
@@ -25,6 +25,8 @@ SOFTWARE.
 #pragma once
 
 #include <cinttypes>
+#include <memory>
+#include <optional>
 #include <utility>
 
 #include "../events/events.hpp"
@@ -47,8 +49,13 @@ public:
      * @brief Construct a new sdl events system object
      *
      * @param render the render object
+     * @param coalesce if the mouse movements and window resizes of a frame are coalesced
+     * @param immediate if the input events are dispatched immediately instead of queued
+     * @see config::coalesce_input
+     * @see config::immediate_input
      */
-    explicit sdl_events_system(std::shared_ptr<render> render): render_{std::move(render)} {};
+    explicit sdl_events_system(std::shared_ptr<render> render, bool coalesce = false, bool immediate = false)
+        : render_{std::move(render)}, coalesce_{coalesce}, immediate_{immediate} {};
 
     /**
      * @brief initialize the system
@@ -68,10 +75,47 @@ public:
      */
     void update(world *world) override;
 
+    /**
+     * @brief get the access of the system, it polls SDL events so it is exclusive and runs on the main thread
+     * @return the access of the system
+     */
+    [[nodiscard]] auto access() const -> system_access override;
+
 private:
     //! the render object
     std::shared_ptr<sneze::render> render_;
 
+    //! if the mouse movements and window resizes of a frame are coalesced
+    bool coalesce_{false};
+
+    //! if the input events are dispatched immediately
+    bool immediate_{false};
+
+    //! the coalesced mouse movement, if any
+    std::optional<events::mouse_moved> mouse_moved_{};
+
+    //! the coalesced window resize, if any
+    std::optional<events::window_resized> window_resized_{};
+
+    //! dispatch an input event, immediately or queued
+    template<typename EventType, typename... Args>
+    void send(world *world, Args &&...args);
+
+    //! record the time of an input event, to measure the input latency
+    static void input_received(world *world, std::uint32_t timestamp);
+
+    //! emit the coalesced mouse movement, if any
+    void flush_mouse_moved(world *world);
+
+    //! emit the coalesced window resize, if any
+    void flush_window_resized(world *world);
+
+    //! emit a mouse movement, or coalesce it
+    void mouse_moved(world *world, const components::position &point, const components::position &delta);
+
+    //! emit a window resize, or coalesce it
+    void window_resized(world *world, const components::size &window);
+
     //! convert sdl mouse button to sneze mouse button
     static auto sdl_mouse_button_to_sneze(uint8_t button) -> mouse::button;
 };
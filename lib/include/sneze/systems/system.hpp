@@ -24,8 +24,15 @@ SOFTWARE.
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
 #include <entt/fwd.hpp>
 
+#include "system_access.hpp"
+
 namespace sneze {
 
 class world;
@@ -55,6 +62,15 @@ struct system {
      */
     virtual void update(world *world) = 0;
 
+    /**
+     * @brief get the component and global types that the system reads and writes
+     * @note by default a system is exclusive, so it does not run in parallel with other systems
+     * @return the access of the system
+     */
+    [[nodiscard]] virtual auto access() const -> system_access {
+        return system_access::exclusive();
+    }
+
     system() = default;
     virtual ~system() = default;
 
@@ -74,11 +90,18 @@ public:
     /**
      * @brief Construct a new system with priority object
      * @param type the type id of the system
+     * @param name the name of the system
      * @param priority the priority of the system
      * @param system the system
+     * @param access the access of the system, if not set the system declares it
      */
-    system_with_priority(const entt::id_type type, std::int32_t priority, std::unique_ptr<system> system)
-        : type_{type}, system_{std::move(system)}, priority_{priority} {}
+    system_with_priority(const entt::id_type type,
+                         std::string name,
+                         std::int32_t priority,
+                         std::unique_ptr<system> system,
+                         std::optional<system_access> access = std::nullopt)
+        : type_{type}, name_{std::move(name)}, system_{std::move(system)}, priority_{priority},
+          access_{access.has_value() ? std::move(*access) : system_->access()} {}
 
     /**
      * @brief initialize the system
@@ -121,13 +144,33 @@ public:
         return type_;
     }
 
+    /**
+     * @brief Get the name of the system
+     * @return the name of the system
+     */
+    [[nodiscard]] inline auto name() const -> const std::string & {
+        return name_;
+    }
+
+    /**
+     * @brief Get the access of the system
+     * @return the component and global types that the system reads and writes
+     */
+    [[nodiscard]] inline auto access() const -> const system_access & {
+        return access_;
+    }
+
 private:
     //! the type id of the system
     entt::id_type type_{};
+    //! the name of the system
+    std::string name_{};
     //! the system
     std::unique_ptr<system> system_{};
     //! the priority of the system
     std::int32_t priority_{};
+    //! the access of the system
+    system_access access_{};
 };
 
 } // namespace sneze
@@ -0,0 +1,243 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace sneze {
+
+/**
+ * @brief declare the component or global types that a system reads
+ * @tparam Types the types that the system reads
+ * @see sneze::world::add_system
+ */
+template<typename... Types>
+struct reads {};
+
+/**
+ * @brief declare the component or global types that a system writes
+ * @tparam Types the types that the system writes
+ * @see sneze::world::add_system
+ */
+template<typename... Types>
+struct writes {};
+
+/**
+ * @brief declare that a system must run on the main thread
+ * @see sneze::world::add_system
+ */
+struct main_thread {};
+
+//! check if a type is a declaration of the access of a system
+template<typename Type>
+struct is_access_declaration: std::false_type {};
+
+//! reads are access declarations
+template<typename... Types>
+struct is_access_declaration<reads<Types...>>: std::true_type {};
+
+//! writes are access declarations
+template<typename... Types>
+struct is_access_declaration<writes<Types...>>: std::true_type {};
+
+//! main thread is an access declaration
+template<>
+struct is_access_declaration<main_thread>: std::true_type {};
+
+/**
+ * @brief the component and global types that a system reads and writes
+ *
+ * the world uses the access of the systems to run in parallel the systems that does not conflict, two systems conflict
+ * if any of them writes a type that the other reads or writes, conflicting systems run in the order of their priority.
+ *
+ * a system that has not declared its access is exclusive, it conflicts with any other system and runs on the main
+ * thread, this is how all the systems run if they do not declare anything.
+ *
+ * note: systems that are not on the main thread must only modify the components that they declare, they must not add
+ * or remove entities, components or systems, or emit events.
+ *
+ * the storages of the declared types are created when the system is added, so the views that systems build while
+ * running in parallel never insert into the registry, this is why any system that declares its access, even on the main
+ * thread, must only get views of the types that it declares.
+ *
+ * @code
+ * auto access = system_access{}.read<game_time>().write<components::position>();
+ * @endcode
+ *
+ * @see sneze::system::access
+ * @see sneze::world::add_system
+ */
+class system_access {
+public:
+    //! a system access that does not read or write anything
+    system_access() = default;
+
+    /**
+     * @brief get the access of a system that could read or write anything
+     * @return an exclusive access, that runs on the main thread
+     */
+    [[nodiscard]] static auto exclusive() -> system_access {
+        auto access = system_access{};
+        access.exclusive_ = true;
+        access.main_thread_ = true;
+        return access;
+    }
+
+    /**
+     * @brief get the access from a list of declarations
+     * @tparam Declarations the declarations, any of sneze::reads, sneze::writes or sneze::main_thread
+     * @return the access
+     */
+    template<typename... Declarations>
+    [[nodiscard]] static auto from() -> system_access {
+        static_assert((is_access_declaration<Declarations>::value && ...),
+                      "the access must be declared using sneze::reads, sneze::writes or sneze::main_thread");
+        auto access = system_access{};
+        (access.declare(Declarations{}), ...);
+        return access;
+    }
+
+    /**
+     * @brief add types that are read
+     * @tparam Types the types that are read
+     * @return this access
+     */
+    template<typename... Types>
+    auto read() -> system_access & {
+        (reads_.push_back(entt::type_hash<Types>::value()), ...);
+        (storages_.push_back(&create_storage<Types>), ...);
+        return *this;
+    }
+
+    /**
+     * @brief add types that are written
+     * @tparam Types the types that are written
+     * @return this access
+     */
+    template<typename... Types>
+    auto write() -> system_access & {
+        (writes_.push_back(entt::type_hash<Types>::value()), ...);
+        (storages_.push_back(&create_storage<Types>), ...);
+        return *this;
+    }
+
+    /**
+     * @brief require to run on the main thread
+     * @return this access
+     */
+    auto on_main_thread() -> system_access & {
+        main_thread_ = true;
+        return *this;
+    }
+
+    /**
+     * @brief check if this access conflicts with other access
+     * @param other the other access
+     * @return true if any of them writes a type that the other reads or writes
+     */
+    [[nodiscard]] auto conflicts(const system_access &other) const -> bool {
+        if(exclusive_ || other.exclusive_) {
+            return true;
+        }
+        return overlaps(writes_, other.writes_) || overlaps(writes_, other.reads_) || overlaps(reads_, other.writes_);
+    }
+
+    /**
+     * @brief create the storages of the types that are read or written, if they do not exist
+     *
+     * types that are not components, like globals, get an empty storage that is not used.
+     *
+     * @param registry the registry where the storages are created
+     */
+    void prepare(entt::registry &registry) const {
+        for(auto create: storages_) {
+            create(registry);
+        }
+    }
+
+    /**
+     * @brief check if the access is exclusive
+     * @return true if it conflicts with any other access
+     */
+    [[nodiscard]] auto is_exclusive() const noexcept -> bool {
+        return exclusive_;
+    }
+
+    /**
+     * @brief check if the access requires the main thread
+     * @return true if the system must run on the main thread
+     */
+    [[nodiscard]] auto is_main_thread() const noexcept -> bool {
+        return main_thread_;
+    }
+
+private:
+    //! types that are read
+    std::vector<entt::id_type> reads_{};
+    //! types that are written
+    std::vector<entt::id_type> writes_{};
+    //! functions that create the storages of the types that are read or written
+    std::vector<void (*)(entt::registry &)> storages_{};
+    //! if it conflicts with any other access
+    bool exclusive_{false};
+    //! if it must run on the main thread
+    bool main_thread_{false};
+
+    //! declare types that are read
+    template<typename... Types>
+    void declare(reads<Types...> /*declaration*/) {
+        read<Types...>();
+    }
+
+    //! declare types that are written
+    template<typename... Types>
+    void declare(writes<Types...> /*declaration*/) {
+        write<Types...>();
+    }
+
+    //! declare that it runs on the main thread
+    void declare(main_thread /*declaration*/) {
+        on_main_thread();
+    }
+
+    //! create the storage of a type in a registry
+    template<typename Type>
+    static void create_storage(entt::registry &registry) {
+        [[maybe_unused]] auto &storage = registry.storage<Type>();
+    }
+
+    //! check if two list of types have any type in common
+    static auto overlaps(const std::vector<entt::id_type> &first, const std::vector<entt::id_type> &second) -> bool {
+        return std::any_of(first.begin(), first.end(), [&second](auto type) {
+            return std::find(second.begin(), second.end(), type) != second.end();
+        });
+    }
+};
+
+} // namespace sneze
@@ -0,0 +1,145 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "../platform/job_system.hpp"
+#include "system.hpp"
+
+namespace sneze {
+
+class world;
+
+/**
+ * @brief run the systems of a world in parallel
+ *
+ * a graph is built from the access of the systems, each system depends on the systems with higher priority that it
+ * conflicts with. Each update the systems run as soon as their dependencies are completed, the systems that must run on
+ * the main thread run on the thread that calls update, in priority order, and the rest run on the job system.
+ *
+ * @see sneze::system_access
+ * @see sneze::job_system
+ */
+class system_scheduler {
+public:
+    //! vector of systems sorted by priority
+    using systems_vector = std::vector<std::unique_ptr<system_with_priority>>;
+
+    /**
+     * @brief build the graph of the systems
+     * @param systems the systems, sorted by priority
+     */
+    void build(const systems_vector &systems);
+
+    /**
+     * @brief update all the systems, returns when all of them are updated
+     * @param world the world that owns the systems
+     * @param systems the systems, same as the last build
+     * @param jobs the job system to use
+     */
+    void update(world *world, const systems_vector &systems, job_system &jobs);
+
+    /**
+     * @brief get the time that a system took on the last update
+     * @param index the index of the system
+     * @return the time in milliseconds
+     */
+    [[nodiscard]] auto elapsed(std::size_t index) const -> float {
+        return nodes_[index].elapsed;
+    }
+
+private:
+    //! a system on the graph
+    struct node {
+        //! the systems that depends on this system
+        std::vector<std::size_t> dependents; // cppcheck-suppress unusedStructMember
+        //! number of systems that this system depends on
+        std::size_t dependencies; // cppcheck-suppress unusedStructMember
+        //! if the system must run on the main thread
+        bool main_thread; // cppcheck-suppress unusedStructMember
+        //! the time that the system took on the last update, in milliseconds
+        float elapsed; // cppcheck-suppress unusedStructMember
+        //! the name of the system on the trace
+        const char *name; // cppcheck-suppress unusedStructMember
+    };
+
+    //! the graph of the systems
+    std::vector<node> nodes_{};
+
+    //! remaining dependencies of each system on the current update
+    std::unique_ptr<std::atomic<std::size_t>[]> remaining_{}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    //! number of systems completed on the current update
+    std::atomic<std::size_t> completed_{0};
+
+    //! the systems ready to run on the main thread
+    std::vector<std::size_t> main_ready_{};
+
+    //! mutex to protect the systems ready to run on the main thread
+    std::mutex main_ready_mutex_{};
+
+    //! the systems running on the job system
+    job_system::counter running_{};
+
+    /**
+     * @brief launch a system that has no pending dependencies
+     * @param world the world that owns the systems
+     * @param systems the systems
+     * @param jobs the job system to use
+     * @param index the index of the system to launch
+     */
+    void launch(world *world, const systems_vector &systems, job_system &jobs, std::size_t index);
+
+    /**
+     * @brief update a system measuring the time it takes
+     * @param world the world that owns the systems
+     * @param systems the systems
+     * @param index the index of the system to update
+     */
+    void run(world *world, const systems_vector &systems, std::size_t index);
+
+    /**
+     * @brief mark a system as completed and launch the systems that depend on it
+     * @param world the world that owns the systems
+     * @param systems the systems
+     * @param jobs the job system to use
+     * @param index the index of the system completed
+     */
+    void complete(world *world, const systems_vector &systems, job_system &jobs, std::size_t index);
+
+    /**
+     * @brief take the system with higher priority ready to run on the main thread
+     * @return the index of the system, if any
+     */
+    auto take_main_ready() -> std::optional<std::size_t>;
+};
+
+} // namespace sneze
@@ -0,0 +1,92 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "../components/hierarchy.hpp"
+
+#include "system.hpp"
+
+namespace sneze {
+
+/**
+ * @brief transform system
+ *
+ * this system calculates the world_transform of the entities in a hierarchy, before they are rendered.
+ *
+ * only the entities whose position, layout, transform or parent have changed are calculated, together with all their
+ * descendants, in breadth first order so each parent is calculated before its children.
+ *
+ * @note modify the position of an entity in a hierarchy with world::patch, or use world::mark_changed
+ * @see components::parent
+ * @see components::world_transform
+ * @see world::set_parent
+ */
+class transform_system: public system {
+public:
+    /**
+     * @brief initialize the system
+     * @param world the world that owns this system
+     */
+    void init(world *world) override;
+
+    /**
+     * @brief shutdown the system
+     * @param world the world that owns this system
+     */
+    void end(world *world) override;
+
+    /**
+     * @brief update the system
+     * @param world the world that owns this system
+     */
+    void update(world *world) override;
+
+    /**
+     * @brief get the access of the system, it runs on the main thread since it may add world transforms
+     * @return the access of the system
+     */
+    [[nodiscard]] auto access() const -> system_access override;
+
+private:
+    //! changes of positions, layouts, transforms and parents since the last update
+    std::unique_ptr<entt::observer> changes_{};
+
+    //! entities that have changed, sorted
+    std::vector<entt::entity> dirty_{};
+
+    //! entities to calculate, in breadth first order
+    std::vector<entt::entity> pending_{};
+
+    //! check if any ancestor of an entity has changed
+    [[nodiscard]] auto has_dirty_ancestor(world *world, entt::entity entity) const -> bool;
+
+    //! calculate the world transform of an entity, from its parent
+    static auto calculate(world *world, entt::entity entity) -> const components::world_transform &;
+};
+
+} // namespace sneze
@@ -26,14 +26,17 @@ SOFTWARE.
 
 #include "sneze/app/world.hpp"
 #include "sneze/effects/effects_system.hpp"
-#include "sneze/embedded/embedded.hpp"
 #include "sneze/events/events.hpp"
 #include "sneze/platform/logger.hpp"
+#include "sneze/platform/startup.hpp"
+#include "sneze/platform/trace.hpp"
 #include "sneze/render/render.hpp"
 #include "sneze/systems/keys_system.hpp"
 #include "sneze/systems/layout_system.hpp"
+#include "sneze/systems/profiler_overlay_system.hpp"
 #include "sneze/systems/render_system.hpp"
 #include "sneze/systems/sdl_events_system.hpp"
+#include "sneze/systems/transform_system.hpp"
 
 #include <string>
 
@@ -64,7 +67,9 @@ auto application::run() -> result<bool, error> {
 #if defined(NDEBUG) && defined(_WIN32)
 #    pragma comment(linker, "/SUBSYSTEM:windows /ENTRY:mainCRTStartup")
 #endif
+    startup::begin();
     logger::setup_log();
+    startup::mark("logger");
     logger::info("running application: {} (Team: {})", get_name(), get_team());
 
     if(auto err = read_settings().ko()) {
@@ -110,8 +115,11 @@ void application::log_level() {
 auto application::launch() -> result<> {
     logger::trace("configure application");
     auto config = configure();
+    trace_file_ = config.get_trace_file();
+    startup::mark("configure");
 
     auto [window, fullscreen, monitor] = get_window_settings(config);
+    auto driver = get_render_driver_settings(config);
 
     logger::trace("init render");
     if(auto err = render_
@@ -121,67 +129,96 @@ auto application::launch() -> result<> {
                              monitor,
                              fmt::format("{} - {}", get_team(), get_name()),
                              config.get_window_icon(),
-                             config.get_clear_color())
+                             config.get_clear_color(),
+                             config.get_subsystems(),
+                             driver)
                       .ko()) {
         logger::error("error initializing render");
         return error("Can't init the render system.", *err);
     }
+    save_render_driver_settings(driver);
+    render_->configure_capture(config.get_capture_folder(), config.get_capture_format(), config.get_capture_frames());
+
+    if(config.get_dynamic_resolution_fps() > 0.F) {
+        if(auto err = render_
+                          ->enable_dynamic_resolution(config.get_dynamic_resolution_fps(),
+                                                      config.get_dynamic_resolution_min_scale())
+                          .ko()) {
+            logger::warning("dynamic resolution not available, rendering at full resolution");
+        }
+    }
+    startup::mark("render setup");
 
     logger::trace("init world");
     world_->init();
 
+    logger::trace("listening for dump_trace events");
+    world_->add_listener<events::dump_trace, &application::dump_trace>(this);
+
     constexpr auto render_priority = world::priority::after_applications;
     constexpr auto sdl_events_priority = world::priority::before_applications;
     constexpr auto keys_priority = sdl_events_priority - 1;
-    constexpr auto layout_priority = render_priority + 1;
+    constexpr auto transform_priority = render_priority + 1;
+    constexpr auto layout_priority = transform_priority + 1;
     constexpr auto effects_priority = layout_priority + 1;
+    constexpr auto profiler_overlay_priority = effects_priority + 1;
 
     logger::trace("adding render system to the world");
     world_->add_system_with_priority_internal<render_priority, render_system>(render_);
 
     logger::trace("adding event system to the world");
-    world_->add_system_with_priority_internal<sdl_events_priority, sdl_events_system>(render_);
+    world_->add_system_with_priority_internal<sdl_events_priority, sdl_events_system>(
+        render_, config.get_coalesce_input(), config.get_immediate_input());
 
     logger::trace("adding key system to the world");
     world_->add_system_with_priority_internal<keys_priority, keys_system>(config.get_exit_key(),
-                                                                          config.get_toggle_full_screen_key());
+                                                                          config.get_toggle_full_screen_key(),
+                                                                          config.get_toggle_profiler_overlay_key(),
+                                                                          config.get_dump_trace_key(),
+                                                                          config.get_capture_key());
 
     logger::trace("adding layout system to the world");
     world_->add_system_with_priority_internal<layout_priority, layout_system>();
 
+    logger::trace("adding transform system to the world");
+    world_->add_system_with_priority_internal<transform_priority, transform_system>();
+
     logger::trace("adding effects system to the world");
     world_->add_system_with_priority_internal<effects_priority, effects_system>();
 
+    logger::trace("adding profiler overlay system to the world");
+    world_->add_system_with_priority_internal<profiler_overlay_priority, profiler_overlay_system>(render_);
+
     logger::trace("listening for application_want_closing events");
     world_->add_listener<events::application_want_closing, &application::app_want_closing>(this);
 
-    logger::trace("loading embedded fonts");
-    if(auto err = load_embedded_fonts().ko()) {
-        logger::error("error loading embedded fonts");
-        render_->end();
-        return error("Can't init the application.", *err);
-    }
+    startup::mark("world");
 
     logger::trace("update initial world state");
     world_->update();
+    startup::mark("initial update");
 
     logger::trace("init application");
-    if(auto err = init().ko()) {
+    if(auto err = init_application().ko()) {
         logger::error("error initializing application");
         render_->end();
         return error("Can't init the application.", *err);
     }
+    startup::mark("application init");
 
+    auto first_frame = true;
     while(!want_to_close_) {
+        SNEZE_ZONE("frame");
         world_->update();
+        if(first_frame) [[unlikely]] {
+            first_frame = false;
+            report_startup();
+        }
     }
 
     logger::trace("ending application");
     end();
 
-    logger::trace("unloading embedded fonts");
-    unload_embedded_fonts();
-
     logger::trace("remove any listener by sneze::application");
     world_->remove_listeners(this);
 
@@ -194,9 +231,44 @@ auto application::launch() -> result<> {
     logger::trace("ending render");
     render_->end();
 
+    if constexpr(trace::enabled()) {
+        if(auto err = trace::dump(trace_file_).ko(); err) {
+            logger::error("error dumping the trace at exit");
+        }
+    }
+
     return true;
 }
 
+auto application::init_application() -> result<> {
+    SNEZE_ZONE("application::init");
+    return init();
+}
+
+void application::report_startup() {
+    startup::mark("first frame");
+    startup::log();
+
+    if(auto file = startup::report_file(); file) {
+        if(auto err = startup::dump(*file).ko(); err) {
+            logger::error("error writing the startup report");
+        }
+    }
+
+    if(startup::exit_after_first_frame()) {
+        logger::info("closing after the first frame since SNEZE_EXIT_AFTER_FIRST_FRAME is set");
+        want_to_close_ = true;
+    }
+}
+
+void application::dump_trace(const events::dump_trace & /*event*/) {
+    if constexpr(!trace::enabled()) {
+        logger::warning("can't dump the trace, sneze is built without SNEZE_ENABLE_TRACE");
+    } else if(auto err = trace::dump(trace_file_).ko(); err) {
+        logger::error("error dumping the trace");
+    }
+}
+
 auto application::read_settings() noexcept -> result<> {
     if(auto [val, err] = settings_.read().ok(); err) {
         logger::error("error reading settings");
@@ -229,6 +301,15 @@ auto application::load_font(const std::string &font_path) -> result<> {
     return true;
 }
 
+auto application::require_subsystems(const device::subsystems &subsystems) -> result<> {
+    if(auto err = render_->require_subsystems(subsystems).ko(); err) {
+        logger::error("error initializing subsystems: {}", device::subsystem::string(subsystems));
+        return error("Can't init subsystems.", *err);
+    }
+
+    return true;
+}
+
 void application::unload_font(const std::string &font_path) {
     render_->unload_font(font_path);
 }
@@ -259,6 +340,28 @@ void application::unload_sprite(const std::string &sprite_path) {
     render_->unload_sprite(sprite_path);
 }
 
+auto application::preload(const manifest &assets) -> result<> {
+    auto progress = [this](std::size_t done, std::size_t total) {
+        world_->trigger<events::preload_progress>(done, total);
+    };
+
+    if(auto err = render_->preload(assets, world_->jobs(), progress).ko(); err) {
+        logger::error("error preloading assets");
+        return error("Can't preload assets.", *err);
+    }
+
+    return true;
+}
+
+void application::unload(const manifest &assets) {
+    render_->unload(assets);
+}
+
+auto application::get_frame_index(const std::string &sprite_sheet_path, const std::string &frame)
+    -> result<std::size_t, error> {
+    return render_->get_frame_index(sprite_sheet_path, frame);
+}
+
 auto application::get_window_settings(const config &cfg) -> std::tuple<components::size, bool, int> {
     using namespace std::literals;
     auto width = settings_.get("window"s, "width"s, static_cast<std::int64_t>(cfg.get_window_size().width));
@@ -282,22 +385,26 @@ void application::save_window_settings() {
     settings_.set("window"s, "monitor"s, static_cast<std::int64_t>(render_->get_monitor()));
 }
 
-auto application::load_embedded_fonts() -> result<> {
-    if(auto err = load_font(embedded::mono_font).ko(); err) {
-        logger::error("error loading mono font");
-        return error("Can't load embedded mono font.", *err);
-    }
+auto application::get_render_driver_settings(const config &cfg) -> render_driver {
+    using namespace std::literals;
+    auto driver = render_driver{};
+    driver.probe = cfg.get_probe_render_driver();
+    driver.forced = settings_.get("render"s, "override"s, ""s);
+    driver.probed = settings_.get("render"s, "driver"s, ""s);
+    driver.sdl_version = settings_.get("render"s, "sdl_version"s, ""s);
+    driver.display = settings_.get("render"s, "display"s, ""s);
+    return driver;
+}
 
-    if(auto err = load_font(embedded::regular_font).ko(); err) {
-        logger::error("error loading regular font");
-        return error("Can't load embedded regular font.", *err);
+void application::save_render_driver_settings(const render_driver &driver) {
+    using namespace std::literals;
+    // games that do not probe the drivers do not get the render settings written
+    if(!driver.probe) {
+        return;
     }
-
-    return true;
-}
-void application::unload_embedded_fonts() {
-    unload_font(embedded::mono_font);
-    unload_font(embedded::regular_font);
+    settings_.set("render"s, "driver"s, driver.probed);
+    settings_.set("render"s, "sdl_version"s, driver.sdl_version);
+    settings_.set("render"s, "display"s, driver.display);
 }
 
 } // namespace sneze
@@ -0,0 +1,49 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/app/event_channel.hpp"
+
+namespace sneze {
+
+void event_channels::drain(entt::dispatcher &dispatcher) {
+    for(auto &slot: channels_) {
+        if(auto *channel = slot.load(std::memory_order_acquire); channel != nullptr) {
+            channel->drain(dispatcher);
+        }
+    }
+}
+
+void event_channels::clear() {
+    for(auto &slot: channels_) {
+        // take back the ownership of the channel to destroy it
+        auto channel = std::unique_ptr<event_channel_base>{slot.exchange(nullptr, std::memory_order_acq_rel)};
+    }
+}
+
+auto event_channels::next_channel_index() -> std::size_t {
+    static auto next = std::atomic<std::size_t>{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace sneze
@@ -0,0 +1,84 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/app/frame_profiler.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace sneze {
+
+void frame_profiler::reset(std::vector<std::string> names) {
+    names_ = std::move(names);
+    samples_.assign(names_.size(), samples{});
+    next_ = 0;
+    count_ = 0;
+}
+
+void frame_profiler::end_frame(float frame_time, frame_profile &profile) {
+    frame_times_[next_] = frame_time;
+    next_ = (next_ + 1) % frames;
+    count_ = std::min(count_ + 1, frames);
+
+    // the oldest frame is the next to be overwritten, once all the frames are recorded
+    const auto oldest = count_ == frames ? next_ : 0;
+    profile.frames.resize(count_);
+    for(std::size_t index = 0; index < count_; ++index) {
+        profile.frames[index] = frame_times_[(oldest + index) % frames];
+    }
+
+    auto frame_section = section_profile{};
+    calculate(frame_times_, frame_section);
+    profile.frame_time = frame_section.avg;
+    profile.fps = frame_section.avg > 0.F ? 1000.F / frame_section.avg : 0.F;
+
+    profile.sections.resize(names_.size());
+    for(std::size_t section = 0; section < names_.size(); ++section) {
+        auto &stats = profile.sections[section];
+        stats.name = names_[section];
+        calculate(samples_[section], stats);
+    }
+}
+
+void frame_profiler::calculate(const samples &values, section_profile &section) {
+    if(count_ == 0) {
+        section.last = section.min = section.avg = section.p99 = 0.F;
+        return;
+    }
+
+    // the first count_ samples are the recorded ones, in any order
+    sorted_.assign(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(count_));
+    const auto last = (next_ + frames - 1) % frames;
+    section.last = values[last];
+    section.min = *std::min_element(sorted_.begin(), sorted_.end());
+    section.avg = std::accumulate(sorted_.begin(), sorted_.end(), 0.F) / static_cast<float>(count_);
+
+    const auto percentile = (count_ * 99 + 99) / 100 - 1;
+    const auto nth = sorted_.begin() + static_cast<std::ptrdiff_t>(percentile);
+    std::nth_element(sorted_.begin(), nth, sorted_.end());
+    section.p99 = *nth;
+}
+
+} // namespace sneze
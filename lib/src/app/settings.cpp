@@ -24,6 +24,7 @@ SOFTWARE.
 
 #include "sneze/app/settings.hpp"
 
+#include "sneze/platform/startup.hpp"
 #include "sneze/platform/version.hpp"
 
 #include <filesystem>
@@ -53,12 +54,14 @@ auto settings::read() -> result<> {
         logger::error("error calculate settings file path");
         return error("Can't calculate settings file path.", *err); // NOLINT(bugprone-unchecked-optional-access)
     }
+    startup::mark("settings directory");
 
     if(auto err = read_json().ko()) {
         logger::error("error reading json file: {}", settings_file_path_.string());
         return error("Can't read settings file.", *err); // NOLINT(bugprone-unchecked-optional-access)
     }
 
+    startup::mark("settings file");
     logger::trace("settings file read");
     return true;
 }
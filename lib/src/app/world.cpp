@@ -24,28 +24,150 @@ SOFTWARE.
 #include "sneze/app/world.hpp"
 
 #include "sneze/platform/logger.hpp"
+#include "sneze/platform/trace.hpp"
 
+#include <atomic>
 #include <chrono>
 
 namespace sneze {
 
 void world::update() {
+    using clock = std::chrono::high_resolution_clock;
+
+    // the frame time is the time between the start of the updates, as the game time delta
+    const auto frame_start = clock::now();
+    const auto frame_time = frame_start_ == clock::time_point{}
+                                ? 0.F
+                                : std::chrono::duration<float, std::milli>(frame_start - frame_start_).count();
+    frame_start_ = frame_start;
+
     update_time();
     update_systems();
+    apply_commands();
+
+    const auto events_start = clock::now();
     sent_events();
+    profiler_.record(systems_.size(), std::chrono::duration<float, std::milli>(clock::now() - events_start).count());
+
+    apply_commands();
+    expire_changes();
+    profiler_.end_frame(frame_time, get_global<frame_profile>());
+}
+
+void world::expire_changes() {
+    for(auto &tracker: change_trackers_) {
+        if(tracker) {
+            tracker->taken = false;
+        }
+    }
+}
+
+auto world::set_parent(entt::entity entity, entt::entity parent) -> result<> {
+    if(!registry_.valid(entity) || !registry_.valid(parent)) {
+        logger::error("can't set the parent of an entity, invalid entity or parent");
+        return error("Can't set parent.");
+    }
+
+    for(auto ancestor = parent; registry_.valid(ancestor);) {
+        if(ancestor == entity) {
+            logger::error("can't set the parent of an entity to itself or one of its descendants");
+            return error("Can't set parent.");
+        }
+        if(const auto *next = registry_.try_get<components::parent>(ancestor)) {
+            ancestor = next->entity;
+        } else {
+            break;
+        }
+    }
+
+    remove_parent(entity);
+    registry_.emplace<components::parent>(entity, parent);
+    auto &children = registry_.get_or_emplace<components::children>(parent);
+    children.entities.push_back(entity);
+    registry_.patch<components::children>(parent);
+
+    return true;
+}
+
+void world::remove_parent(entt::entity entity) {
+    if(!registry_.valid(entity) || !registry_.all_of<components::parent>(entity)) {
+        return;
+    }
+    // unlinking from the parent is done when the component is destroyed
+    registry_.remove<components::parent>(entity);
+
+    // the entity is now a root, or not in a hierarchy
+    if(registry_.all_of<components::children>(entity)) {
+        registry_.patch<components::children>(entity);
+    } else {
+        registry_.remove<components::world_transform>(entity);
+    }
+}
+
+void world::unlink_from_parent(entt::registry & /*registry*/, entt::entity entity) {
+    const auto parent = registry_.get<components::parent>(entity).entity;
+    auto *children = registry_.try_get<components::children>(parent);
+    if(children == nullptr || std::erase(children->entities, entity) == 0) {
+        return;
+    }
+    if(!children->entities.empty()) {
+        registry_.patch<components::children>(parent);
+    } else {
+        registry_.remove<components::children>(parent);
+        if(!registry_.all_of<components::parent>(parent)) {
+            registry_.remove<components::world_transform>(parent);
+        }
+    }
+}
+
+void world::orphan_children(entt::registry & /*registry*/, entt::entity entity) {
+    // take the children first, so unlinking them does not modify the component that is being destroyed
+    auto orphans = std::vector<entt::entity>{};
+    orphans.swap(registry_.get<components::children>(entity).entities);
+    for(auto child: orphans) {
+        if(const auto *parent = registry_.try_get<components::parent>(child); parent && parent->entity == entity) {
+            remove_parent(child);
+        }
+    }
+}
+
+void world::apply_commands() {
+    SNEZE_ZONE("world::apply_commands");
+    for(auto &buffer: command_buffers_) {
+        if(!buffer.empty()) {
+            buffer.apply(registry_);
+        }
+    }
 }
 
 void world::update_systems() {
+    SNEZE_ZONE("world::update_systems");
+    auto changed = false;
     if(!systems_to_add_.empty()) {
         add_pending_systems();
+        changed = true;
     }
 
     if(!systems_to_remove_.empty()) {
         remove_pending_systems();
+        changed = true;
+    }
+
+    if(changed) {
+        scheduler_.build(systems_);
+
+        auto sections = std::vector<std::string>{};
+        sections.reserve(systems_.size() + 1);
+        for(const auto &system: systems_) {
+            sections.push_back(system->name());
+        }
+        sections.emplace_back("events");
+        profiler_.reset(std::move(sections));
     }
 
-    for(auto &system: systems_) {
-        system->update(this);
+    scheduler_.update(this, systems_, jobs_);
+    for(std::size_t index = 0; index < systems_.size(); ++index) {
+        profiler_.record(index, scheduler_.elapsed(index));
     }
 }
 
@@ -53,6 +175,7 @@ void world::add_pending_systems() {
     logger::trace("adding systems");
     for(auto &system: systems_to_add_) {
         systems_.push_back(std::move(system));
+        systems_.back()->access().prepare(registry_);
         systems_.back()->init(this);
     }
     systems_to_add_.clear();
@@ -100,7 +223,32 @@ auto world::sort_by_priority(const system_ptr &lhs, const system_ptr &rhs) noexc
 }
 
 void world::sent_events() {
-    event_dispatcher_.update();
+    SNEZE_ZONE("world::sent_events");
+    event_channels_.drain(event_dispatcher_);
+
+    // events sent by the listeners are dispatched on the same update, up to a limit
+    for(std::size_t pass = 0; pass < max_event_passes && event_dispatcher_.size() != 0; ++pass) {
+        event_dispatcher_.update();
+    }
+    if(event_dispatcher_.size() != 0) {
+        logger::trace("events pending after {} passes, dispatched on next update", max_event_passes);
+    }
+
+    if(auto &latency = get_global<input_latency>(); latency.pending && !latency.is_handled) {
+        latency.is_handled = true;
+        latency.handled_time = now();
+    }
+
+    for(auto &batch: event_batches_) {
+        if(batch) {
+            batch->deliver();
+        }
+    }
+    for(auto &hooks: component_hooks_) {
+        if(hooks) {
+            hooks->deliver();
+        }
+    }
 }
 
 void world::discard_pending_events() noexcept {
@@ -113,6 +261,19 @@ void world::clear() {
     logger::trace("discarding pending events");
     discard_pending_events();
 
+    logger::trace("removing component listeners");
+    for(auto &hooks: component_hooks_) {
+        if(hooks) {
+            hooks->detach(registry_);
+        }
+    }
+    component_hooks_.clear();
+
+    logger::trace("discarding pending commands");
+    for(auto &buffer: command_buffers_) {
+        buffer.clear();
+    }
+
     logger::trace("removing systems pending to be deleted");
     remove_pending_systems();
 
@@ -121,9 +282,14 @@ void world::clear() {
 
     logger::trace("resetting dispatcher");
     event_dispatcher_ = entt::dispatcher{};
+    event_batches_.clear();
+    event_channels_.clear();
 
     logger::trace("removing globals");
-    remove_global<game_time>();
+    globals_.clear();
+
+    logger::trace("removing change trackers");
+    change_trackers_.clear();
 
     logger::trace("checking for not clear entities & orphans");
     registry_.each([this](entt::entity entity) {
@@ -144,9 +310,16 @@ void world::clear() {
     });
 
     logger::trace("clear registry");
+    registry_.on_destroy<components::parent>().disconnect<&world::unlink_from_parent>(*this);
+    registry_.on_destroy<components::children>().disconnect<&world::orphan_children>(*this);
     registry_.clear();
 }
 
+auto world::next_slot_index() -> std::size_t {
+    static auto next = std::atomic<std::size_t>{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 auto world::since_epoch() -> float {
     namespace chrono = std::chrono;
     auto milliseconds =
@@ -158,10 +331,17 @@ void world::init() {
     logger::trace("world init");
     start_.elapsed = since_epoch();
     start_.delta = 0.0;
+    start_time_ = std::chrono::steady_clock::now();
+    registry_.on_destroy<components::parent>().connect<&world::unlink_from_parent>(*this);
+    registry_.on_destroy<components::children>().connect<&world::orphan_children>(*this);
+    main_thread_ = std::this_thread::get_id();
+    jobs_.start();
+    command_buffers_.resize(jobs_.size());
 }
 
 void world::end() {
     logger::trace("world end");
+    jobs_.stop();
     clear();
 }
 
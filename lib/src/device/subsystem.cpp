@@ -0,0 +1,60 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/device/subsystem.hpp"
+
+#include <array>
+#include <utility>
+
+#include <SDL.h>
+
+namespace sneze::device {
+
+[[maybe_unused]] const subsystems subsystem::none = 0;
+[[maybe_unused]] const subsystems subsystem::audio = SDL_INIT_AUDIO;
+[[maybe_unused]] const subsystems subsystem::joystick = SDL_INIT_JOYSTICK;
+[[maybe_unused]] const subsystems subsystem::haptic = SDL_INIT_HAPTIC;
+[[maybe_unused]] const subsystems subsystem::game_controller = SDL_INIT_GAMECONTROLLER;
+[[maybe_unused]] const subsystems subsystem::sensor = SDL_INIT_SENSOR;
+
+auto subsystem::string(const subsystems &value) -> std::string {
+    const auto names = std::array{std::pair{audio, "Audio"},
+                                  std::pair{joystick, "Joystick"},
+                                  std::pair{haptic, "Haptic"},
+                                  std::pair{game_controller, "Game Controller"},
+                                  std::pair{sensor, "Sensor"}};
+
+    auto text = std::string{};
+    for(const auto &[flag, name]: names) {
+        if((value & flag) == flag) {
+            if(!text.empty()) {
+                text += "+";
+            }
+            text += name;
+        }
+    }
+    return text;
+}
+
+} // namespace sneze::device
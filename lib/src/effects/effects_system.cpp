@@ -31,8 +31,9 @@ SOFTWARE.
 
 namespace sneze {
 
-void effects_system::init(world * /*world*/) {
+void effects_system::init(world *world) {
     logger::trace("effects system::init");
+    time_ = &world->get_global<game_time>();
 }
 
 void effects_system::end(world * /*world*/) {
@@ -40,26 +41,30 @@ void effects_system::end(world * /*world*/) {
 }
 
 void effects_system::update(world *world) {
-    auto time = world->get_global<game_time>();
-    for(auto const &&[entity, alternate_color, color]:
-        world->get_entities<effects::alternate_color, components::color>()) {
-        color = alternate_color.from;
-        alternate_color.current_time += time.delta;
-        if(alternate_color.pause) {
-            if(alternate_color.current_time > alternate_color.delay) {
-                alternate_color.pause = false;
+    const auto delta = time_->delta;
+    world->parallel_each<effects::alternate_color, components::color>(
+        [delta](entt::entity /*entity*/, effects::alternate_color &alternate_color, components::color &color) {
+            color = alternate_color.from;
+            alternate_color.current_time += delta;
+            if(alternate_color.pause) {
+                if(alternate_color.current_time > alternate_color.delay) {
+                    alternate_color.pause = false;
+                    alternate_color.current_time = 0.0F;
+                }
+                return;
+            }
+            if(alternate_color.current_time > alternate_color.time) {
                 alternate_color.current_time = 0.0F;
+                alternate_color.pause = true;
+                std::swap(alternate_color.from, alternate_color.to);
+                return;
             }
-            continue;
-        }
-        if(alternate_color.current_time > alternate_color.time) {
-            alternate_color.current_time = 0.0F;
-            alternate_color.pause = true;
-            std::swap(alternate_color.from, alternate_color.to);
-            continue;
-        }
-        color.blend(alternate_color.to, alternate_color.current_time / alternate_color.time);
-    }
+            color.blend(alternate_color.to, alternate_color.current_time / alternate_color.time);
+        });
+}
+
+auto effects_system::access() const -> system_access {
+    return system_access{}.read<game_time>().write<effects::alternate_color, components::color>();
 }
 
 } // namespace sneze
\ No newline at end of file
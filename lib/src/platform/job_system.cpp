@@ -0,0 +1,182 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/platform/job_system.hpp"
+
+#include "sneze/platform/logger.hpp"
+
+namespace sneze {
+
+namespace {
+//! the worker index of the current thread, 0 for threads that are not workers
+thread_local std::size_t current_worker_index = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace
+
+job_system::~job_system() {
+    stop();
+}
+
+void job_system::start(std::size_t workers) {
+    if(!workers_.empty()) {
+        logger::warning("job system already started");
+        return;
+    }
+
+    if(workers == 0) {
+        workers = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    }
+
+    logger::trace("starting job system with {} workers", workers);
+
+    stopping_ = false;
+    queues_.clear();
+    for(std::size_t i = 0; i <= workers; ++i) {
+        queues_.push_back(std::make_unique<queue>());
+    }
+
+    workers_.reserve(workers);
+    for(std::size_t i = 1; i <= workers; ++i) {
+        workers_.emplace_back(&job_system::worker_loop, this, i);
+    }
+}
+
+void job_system::stop() {
+    if(workers_.empty()) {
+        return;
+    }
+
+    {
+        const auto lock = std::scoped_lock{sleep_mutex_};
+        stopping_ = true;
+    }
+    wake_up_.notify_all();
+
+    for(auto &worker: workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    // jobs queued after the workers stopped run in this thread
+    while(run_pending()) {
+    }
+
+    logger::trace("job system stopped");
+}
+
+void job_system::run(counter &counter, job job) {
+    counter.pending_.fetch_add(1, std::memory_order_relaxed);
+
+    if(queues_.empty() || workers_.empty()) {
+        // not started, the job runs right away
+        job();
+        counter.pending_.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    // count the job before publishing it, so a worker that takes it right away never takes the count below zero
+    {
+        const auto lock = std::scoped_lock{sleep_mutex_};
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+
+    auto worker = current_worker();
+    auto &own_queue = *queues_[worker];
+    try {
+        const auto lock = std::scoped_lock{own_queue.mutex};
+        own_queue.jobs.push_back(entry{std::move(job), &counter});
+    } catch(...) {
+        // the job was not queued
+        queued_.fetch_sub(1, std::memory_order_release);
+        counter.pending_.fetch_sub(1, std::memory_order_release);
+        throw;
+    }
+    wake_up_.notify_one();
+}
+
+void job_system::wait(const counter &counter) {
+    while(!counter.done()) {
+        if(!run_pending()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto job_system::run_pending() -> bool {
+    if(auto found = entry{}; take(current_worker(), found)) {
+        found.function();
+        found.owner->pending_.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+auto job_system::current_worker() noexcept -> std::size_t {
+    return current_worker_index;
+}
+
+auto job_system::take(std::size_t worker, entry &found) -> bool {
+    if(queued_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    const auto total = queues_.size();
+    for(std::size_t i = 0; i < total; ++i) {
+        const auto index = (worker + i) % total;
+        auto &current = *queues_[index];
+        const auto lock = std::scoped_lock{current.mutex};
+        if(current.jobs.empty()) {
+            continue;
+        }
+        // newest job from our own queue, oldest job when stealing
+        if(index == worker) {
+            found = std::move(current.jobs.back());
+            current.jobs.pop_back();
+        } else {
+            found = std::move(current.jobs.front());
+            current.jobs.pop_front();
+        }
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    return false;
+}
+
+void job_system::worker_loop(std::size_t worker) {
+    current_worker_index = worker;
+
+    while(true) {
+        if(run_pending()) {
+            continue;
+        }
+
+        auto lock = std::unique_lock{sleep_mutex_};
+        wake_up_.wait(lock, [this]() { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+        if(stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace sneze
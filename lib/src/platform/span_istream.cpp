@@ -33,4 +33,30 @@ span_stream_buffer::span_stream_buffer(std::span<const std::byte> span) {
     setg(begin, begin, end);
 }
 
+auto span_stream_buffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which)
+    -> pos_type {
+    if((which & std::ios_base::in) == 0) {
+        return pos_type(off_type(-1));
+    }
+
+    auto base = off_type{0};
+    if(direction == std::ios_base::cur) {
+        base = gptr() - eback();
+    } else if(direction == std::ios_base::end) {
+        base = egptr() - eback();
+    }
+
+    const auto position = base + offset;
+    if((position < 0) || (position > (egptr() - eback()))) {
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + position, egptr()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return pos_type(position);
+}
+
+auto span_stream_buffer::seekpos(pos_type position, std::ios_base::openmode which) -> pos_type {
+    return seekoff(off_type(position), std::ios_base::beg, which);
+}
+
 } // namespace sneze::internal
\ No newline at end of file
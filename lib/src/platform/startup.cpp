@@ -0,0 +1,157 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/platform/startup.hpp"
+
+#include "sneze/platform/logger.hpp"
+#include "sneze/platform/trace.hpp"
+
+#include <cstdlib>
+#include <fstream>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace sneze::startup {
+
+namespace {
+
+//! microseconds in a millisecond
+constexpr auto micro_per_milli = 1000.;
+
+//! the state of the startup
+struct state {
+    //! when the startup began, in microseconds on the trace clock
+    double began = 0.;
+    //! when the last phase ended, in microseconds on the trace clock
+    double last = 0.;
+    //! the phases recorded
+    std::vector<phase> phases;
+};
+
+auto current() -> state & {
+    static auto instance = state{};
+    return instance;
+}
+
+auto environment(const char *name) -> std::optional<std::string> {
+    if(const auto *value = std::getenv(name); value != nullptr) { // NOLINT(concurrency-mt-unsafe)
+        return std::string{value};
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+void begin() {
+    auto &startup = current();
+    startup.began = trace::now();
+    startup.last = startup.began;
+    startup.phases.clear();
+}
+
+void mark(std::string_view name) {
+    auto &startup = current();
+    const auto end = trace::now();
+    if constexpr(trace::enabled()) {
+        trace::record(trace::intern(name), startup.last, end);
+    }
+    startup.phases.push_back(
+        {std::string{name}, (startup.last - startup.began) / micro_per_milli, (end - startup.last) / micro_per_milli});
+    startup.last = end;
+}
+
+auto phases() -> const std::vector<phase> & {
+    return current().phases;
+}
+
+auto total() -> double {
+    const auto &startup = current();
+    return (startup.last - startup.began) / micro_per_milli;
+}
+
+void log() {
+    logger::info("startup report, total: {:.2f} ms", total());
+    for(const auto &phase: phases()) {
+        logger::info(" - {}: {:.2f} ms (at {:.2f} ms)", phase.name, phase.duration, phase.start);
+    }
+}
+
+auto dump(const std::filesystem::path &path) -> result<> {
+    logger::info("writing startup report to: {}", path.string());
+
+    auto string_buffer = rapidjson::StringBuffer();
+    auto writer = rapidjson::Writer<rapidjson::StringBuffer>(string_buffer);
+    writer.StartObject();
+    writer.Key("total");
+    writer.Double(total());
+    writer.Key("phases");
+    writer.StartArray();
+    for(const auto &phase: phases()) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(phase.name.c_str());
+        writer.Key("start");
+        writer.Double(phase.start);
+        writer.Key("duration");
+        writer.Double(phase.duration);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    std::ofstream file;
+    file.open(path);
+    if(file.fail()) {
+        logger::error("failed to open file: {}", path.string());
+        return error("Can't write startup report.");
+    }
+    file << string_buffer.GetString();
+    if(file.fail()) {
+        logger::error("failed to write file: {}", path.string());
+        file.close();
+        return error("Can't write startup report.");
+    }
+    file.close();
+    if(file.fail()) {
+        logger::error("failed to close file: {}", path.string());
+        return error("Can't write startup report.");
+    }
+
+    return true;
+}
+
+auto report_file() -> std::optional<std::filesystem::path> {
+    if(auto value = environment("SNEZE_STARTUP_REPORT"); value && !value->empty()) {
+        return std::filesystem::path{*value};
+    }
+    return std::nullopt;
+}
+
+auto exit_after_first_frame() -> bool {
+    auto value = environment("SNEZE_EXIT_AFTER_FIRST_FRAME");
+    return value && !value->empty() && *value != "0";
+}
+
+} // namespace sneze::startup
@@ -0,0 +1,251 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/platform/trace.hpp"
+
+#include "sneze/platform/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace sneze::trace {
+
+namespace {
+
+//! a zone recorded
+struct zone_data {
+    //! the name of the zone
+    const char *name; // cppcheck-suppress unusedStructMember
+    //! the time that the zone started, in microseconds
+    double start; // cppcheck-suppress unusedStructMember
+    //! the duration of the zone, in microseconds
+    double duration; // cppcheck-suppress unusedStructMember
+};
+
+//! a slot of a buffer, atomic so a dump could read a zone while its thread overwrites it
+struct slot {
+    //! the name of the zone
+    std::atomic<const char *> name{nullptr};
+    //! the time that the zone started, in microseconds
+    std::atomic<double> start{0.0};
+    //! the duration of the zone, in microseconds
+    std::atomic<double> duration{0.0};
+};
+
+//! number of zones on each block of a buffer
+constexpr std::size_t block_size = 4096;
+
+//! number of blocks of a buffer
+constexpr std::size_t max_blocks = 256;
+
+//! number of zones that a buffer keeps
+constexpr std::size_t capacity = block_size * max_blocks;
+
+//! a block of zones
+using block = std::array<slot, block_size>;
+
+/**
+ * @brief the most recent zones recorded by a thread
+ *
+ * only its thread writes on it, in a ring that overwrites the oldest zones when it is full. the blocks are allocated
+ * when needed. each zone is claimed before it is written and published after, so the published zones could be read
+ * from any thread, discarding the ones that were claimed again while reading.
+ */
+struct thread_buffer {
+    //! the index of the thread
+    std::size_t thread{0};
+    //! the blocks of zones
+    std::array<std::unique_ptr<block>, max_blocks> blocks{};
+    //! the number of zones published
+    std::atomic<std::size_t> count{0};
+    //! the number of zones claimed, it could be one more than the published while a zone is written
+    std::atomic<std::size_t> claimed{0};
+};
+
+//! the buffers of all the threads
+struct buffers {
+    //! mutex to protect the list of buffers, only used once per thread
+    std::mutex mutex;
+    //! the buffers, alive after their threads end
+    std::vector<std::unique_ptr<thread_buffer>> list;
+};
+
+//! get the buffers of all the threads
+auto all_buffers() -> buffers & {
+    static auto instance = buffers{};
+    return instance;
+}
+
+//! get the buffer of the current thread
+auto current_buffer() -> thread_buffer & {
+    thread_local thread_buffer *buffer = nullptr;
+    if(buffer == nullptr) {
+        auto &all = all_buffers();
+        const auto lock = std::scoped_lock{all.mutex};
+        auto &created = all.list.emplace_back(std::make_unique<thread_buffer>());
+        created->thread = all.list.size();
+        buffer = created.get();
+    }
+    return *buffer;
+}
+
+} // namespace
+
+auto now() -> double {
+    using clock = std::chrono::steady_clock;
+    static const auto epoch = clock::now();
+    return std::chrono::duration<double, std::micro>(clock::now() - epoch).count();
+}
+
+void record(const char *name, double start, double end) {
+    auto &buffer = current_buffer();
+    const auto index = buffer.count.load(std::memory_order_relaxed);
+    auto &target = buffer.blocks[(index / block_size) % max_blocks];
+    if(!target) [[unlikely]] {
+        target = std::make_unique<block>();
+    }
+
+    // claim the slot before overwriting it, so a dump that reads it at the same time discards it
+    buffer.claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto &slot = (*target)[index % block_size];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(end - start, std::memory_order_relaxed);
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+auto intern(std::string_view name) -> const char * {
+    static auto mutex = std::mutex{};
+    static auto names = std::unordered_set<std::string>{};
+    const auto lock = std::scoped_lock{mutex};
+    return names.emplace(name).first->c_str();
+}
+
+auto dump(const std::filesystem::path &path) -> result<> {
+    logger::info("dumping trace to: {}", path.string());
+
+    auto string_buffer = rapidjson::StringBuffer();
+    auto writer = rapidjson::Writer<rapidjson::StringBuffer>(string_buffer);
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+
+    auto &all = all_buffers();
+    const auto lock = std::scoped_lock{all.mutex};
+    auto zones = std::size_t{0};
+    auto overwritten = std::size_t{0};
+    auto copied = std::vector<zone_data>{};
+    for(const auto &buffer: all.list) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String("thread_name");
+        writer.Key("ph");
+        writer.String("M");
+        writer.Key("pid");
+        writer.Uint(1);
+        writer.Key("tid");
+        writer.Uint64(buffer->thread);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(fmt::format("thread {}", buffer->thread).c_str());
+        writer.EndObject();
+        writer.EndObject();
+
+        // copy the zones in the ring, then discard the ones that the thread has claimed again while copying
+        const auto count = buffer->count.load(std::memory_order_acquire);
+        const auto begin = count > capacity ? count - capacity : 0;
+        copied.clear();
+        for(auto index = begin; index < count; ++index) {
+            const auto &slot = (*buffer->blocks[(index / block_size) % max_blocks])[index % block_size];
+            copied.push_back({slot.name.load(std::memory_order_relaxed),
+                              slot.start.load(std::memory_order_relaxed),
+                              slot.duration.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto claimed = buffer->claimed.load(std::memory_order_relaxed);
+        const auto first = claimed > capacity ? std::clamp(claimed - capacity, begin, count) : begin;
+
+        for(auto index = first; index < count; ++index) {
+            const auto &zone = copied[index - begin];
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(zone.name);
+            writer.Key("ph");
+            writer.String("X");
+            writer.Key("ts");
+            writer.Double(zone.start);
+            writer.Key("dur");
+            writer.Double(zone.duration);
+            writer.Key("pid");
+            writer.Uint(1);
+            writer.Key("tid");
+            writer.Uint64(buffer->thread);
+            writer.EndObject();
+        }
+        zones += count - first;
+        overwritten += first;
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+
+    std::ofstream file;
+    file.open(path);
+    if(file.fail()) {
+        logger::error("failed to open file: {}", path.string());
+        return error("Can't dump trace file.");
+    }
+    file << string_buffer.GetString();
+    if(file.fail()) {
+        logger::error("failed to write file: {}", path.string());
+        file.close();
+        return error("Can't dump trace file.");
+    }
+    file.close();
+    if(file.fail()) {
+        logger::error("failed to close file: {}", path.string());
+        return error("Can't dump trace file.");
+    }
+
+    logger::info("trace dumped, zones: {}, overwritten: {}", zones, overwritten);
+    return true;
+}
+
+} // namespace sneze::trace
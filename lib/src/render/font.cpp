@@ -24,17 +24,22 @@ SOFTWARE.
 
 #include "sneze/render/font.hpp"
 
+#include "sneze/platform/trace.hpp"
+#include "sneze/platform/utf8.hpp"
 #include "sneze/render/render.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
 namespace sneze {
 
 auto font::init(const std::string &file) -> result<> {
+    SNEZE_ZONE("font::init");
     if(get_render()->file_exists(file)) {
         font_directory_ = get_render()->get_parent(file);
 
@@ -49,6 +54,8 @@ auto font::init(const std::string &file) -> result<> {
             }
         }
 
+        sort_kernings();
+
         if(!validate_parsing()) {
             logger::error("error parsing font file");
             return error{"Error in font format."};
@@ -60,6 +67,31 @@ auto font::init(const std::string &file) -> result<> {
     return error("Error font does not exist.");
 }
 
+auto font::dependencies(class render *render, const std::string &file) -> result<std::vector<std::string>, error> {
+    if(!render->file_exists(file)) {
+        logger::error("error font does not exist: {}", file);
+        return error("Error font does not exist.");
+    }
+
+    const auto directory = render->get_parent(file);
+    auto parser = font{render};
+    auto pages = std::vector<std::string>{};
+
+    auto stream = render->get_istream(file);
+    auto line = std::string{};
+    while(std::getline(*stream, line)) {
+        if(!line.starts_with("page ")) {
+            continue;
+        }
+        auto [type, params] = parser.tokens(line);
+        if(const auto page_file = get_value(params, "file"); !page_file.empty()) {
+            pages.push_back((directory / page_file).string());
+        }
+    }
+
+    return pages;
+}
+
 void font::end() {
     logger::trace("unload font: {}", face_);
 
@@ -70,14 +102,13 @@ void font::end() {
     }
 
     pages_ = {};
-    glyphs_ = {};
-    kernings_ = {};
+    base_glyphs_ = {};
+    extended_glyphs_.clear();
+    kernings_.clear();
+    base_kernings_.reset();
     line_height_ = {0};
-    glyphs_ = {};
     spacing_ = {0, 0};
-    pages_ = {};
     font_directory_ = std::filesystem::path{""};
-    kernings_ = {};
 }
 
 auto font::tokens(const std::string &line) -> std::pair<std::string, params> {
@@ -224,7 +255,7 @@ auto font::parse_page(const params &params) -> bool {
 
 auto font::parse_chars(const params &params) -> bool {
     auto char_count = get_int(params, "count");
-    if((char_count == 0) || (char_count > 256)) {
+    if(char_count <= 0) {
         logger::error("error parsing font file: invalid char count: {}", char_count);
         return false;
     }
@@ -235,7 +266,7 @@ auto font::parse_char(const params &params) -> bool {
     auto new_glyph = glyph{};
 
     const auto char_id = get_int(params, "id");
-    if((char_id < 0) || (char_id > 255)) {
+    if((char_id < 0) || (static_cast<char32_t>(char_id) > utf8::max_codepoint)) {
         logger::error("error parsing font file: invalid glyph id: {}", char_id);
         return false;
     }
@@ -260,7 +291,19 @@ auto font::parse_char(const params &params) -> bool {
         return false;
     }
 
-    glyphs_[char_id] = new_glyph;
+    const auto codepoint = static_cast<std::size_t>(char_id);
+    if(codepoint < glyph_block_size) {
+        base_glyphs_.at(codepoint) = new_glyph;
+    } else {
+        const auto block = codepoint / glyph_block_size;
+        if(block >= extended_glyphs_.size()) {
+            extended_glyphs_.resize(block + 1);
+        }
+        if(extended_glyphs_.at(block) == nullptr) {
+            extended_glyphs_.at(block) = std::make_unique<glyph_block>();
+        }
+        extended_glyphs_.at(block)->at(codepoint % glyph_block_size) = new_glyph;
+    }
 
     return true;
 }
@@ -276,11 +319,21 @@ auto font::parse_kernings(const params &params) -> bool {
 auto font::parse_kerning(const params &params) -> bool {
     auto first = get_int(params, "first");
     auto second = get_int(params, "second");
-    if((first < 0) || (first > 255) || (second < 0) || (second > 255)) {
+    const auto max_codepoint = static_cast<int>(utf8::max_codepoint);
+    if((first < 0) || (first > max_codepoint) || (second < 0) || (second > max_codepoint)) {
         logger::error("error parsing font file: invalid kerning pair: {} {}", first, second);
         return false;
     }
-    kernings_.at(first).at(second) = get_int(params, "amount");
+    const auto amount = get_int(params, "amount");
+    if(amount == 0) {
+        return true;
+    }
+    const auto first_codepoint = static_cast<char32_t>(first);
+    const auto second_codepoint = static_cast<char32_t>(second);
+    kernings_.push_back({kerning_pair(first_codepoint, second_codepoint), static_cast<float>(amount)});
+    if(first_codepoint < glyph_block_size) {
+        base_kernings_.set(first_codepoint);
+    }
     return true;
 }
 
@@ -317,7 +370,12 @@ auto font::validate_parsing() -> bool {
         return false;
     }
 
-    if(!std::any_of(glyphs_.begin(), glyphs_.end(), glyph::valid)) {
+    const auto block_has_glyphs = [](const auto &block) {
+        return (block != nullptr) && std::any_of(block->begin(), block->end(), glyph::valid);
+    };
+
+    if(!std::any_of(base_glyphs_.begin(), base_glyphs_.end(), glyph::valid) &&
+       !std::any_of(extended_glyphs_.begin(), extended_glyphs_.end(), block_has_glyphs)) {
         logger::error("error parsing font file: no valid glyphs");
         return false;
     }
@@ -325,6 +383,38 @@ auto font::validate_parsing() -> bool {
     return true;
 }
 
+void font::sort_kernings() {
+    // later definitions of the same pair win, as they did when kernings were stored in a table
+    std::stable_sort(kernings_.begin(), kernings_.end(), [](const kerning &left, const kerning &right) {
+        return left.pair < right.pair;
+    });
+    auto last = std::unique(kernings_.rbegin(), kernings_.rend(), [](const kerning &left, const kerning &right) {
+        return left.pair == right.pair;
+    });
+    kernings_.erase(kernings_.begin(), last.base());
+    kernings_.shrink_to_fit();
+}
+
+auto font::get_kerning(char32_t first, char32_t second) const noexcept -> float {
+    if(first < glyph_block_size) [[likely]] {
+        if(!base_kernings_.test(first)) {
+            return 0;
+        }
+    } else if(kernings_.empty()) {
+        return 0;
+    }
+
+    const auto pair = kerning_pair(first, second);
+    const auto it_kerning =
+        std::lower_bound(kernings_.begin(), kernings_.end(), pair, [](const kerning &current, std::uint64_t value) {
+            return current.pair < value;
+        });
+    if((it_kerning != kernings_.end()) && (it_kerning->pair == pair)) {
+        return it_kerning->amount;
+    }
+    return 0;
+}
+
 void font::draw_text(const std::string &text,
                      const components::position &position,
                      const components::alignment &alignment,
@@ -358,14 +448,17 @@ void font::draw_text(const std::string &text,
         break;
     }
 
-    unsigned char previous_char = 0;
+    char32_t previous_char = 0;
 
-    for(const auto &current_char: text) {
-        const auto &glyph = glyphs_.at(current_char);
-        if(!glyph::valid(glyph)) {
+    const auto text_view = std::string_view{text};
+    for(std::size_t index = 0; index < text_view.size();) {
+        const auto current_char = utf8::next(text_view, index);
+        const auto *current_glyph = get_glyph(current_char);
+        if((current_glyph == nullptr) || !glyph::valid(*current_glyph)) {
             continue;
         }
-        auto texture_name = pages_.at(glyph.page);
+        const auto &glyph = *current_glyph;
+        const auto &texture_name = pages_.at(glyph.page);
         const auto texture = get_render()->get_texture(texture_name);
 
         if(texture == nullptr) {
@@ -377,7 +470,7 @@ void font::draw_text(const std::string &text,
         const auto src = rect{{glyph.position.x, glyph.position.y}, {glyph.size.width, glyph.size.height}};
 
         if(previous_char != 0U) {
-            current_position.x += static_cast<float>(kernings_.at(previous_char).at(current_char)) * scale_size;
+            current_position.x += get_kerning(previous_char, current_char) * scale_size;
         }
 
         const auto dst = rect{
@@ -385,6 +478,7 @@ void font::draw_text(const std::string &text,
             {glyph.size.width * scale_size, glyph.size.height * scale_size}};
 
         texture->draw(src, dst, color);
+        get_render()->count_glyph();
 
         current_position.x += (glyph.advance * scale_size);
         current_position.x += (spacing_.x * scale_size);
@@ -399,18 +493,21 @@ font::~font() {
 
 auto font::size(const std::string &text, const float &size) const -> components::size {
     auto scale_size = size / static_cast<float>(line_height_);
-    unsigned char previous_char = 0;
+    char32_t previous_char = 0;
 
     float advance = 0;
 
-    for(const auto &current_character: text) {
-        const auto &glyph = glyphs_.at(current_character);
-        if(!glyph::valid(glyph)) {
+    const auto text_view = std::string_view{text};
+    for(std::size_t index = 0; index < text_view.size();) {
+        const auto current_character = utf8::next(text_view, index);
+        const auto *current_glyph = get_glyph(current_character);
+        if((current_glyph == nullptr) || !glyph::valid(*current_glyph)) {
             continue;
         }
+        const auto &glyph = *current_glyph;
 
         if(previous_char != 0U) {
-            advance += static_cast<float>(kernings_.at(previous_char).at(current_character)) * scale_size;
+            advance += get_kerning(previous_char, current_character) * scale_size;
         }
 
         advance += (glyph.advance * scale_size);
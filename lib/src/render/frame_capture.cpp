@@ -0,0 +1,272 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/render/frame_capture.hpp"
+
+#include "sneze/platform/logger.hpp"
+#include "sneze/platform/trace.hpp"
+
+#include <array>
+#include <fstream>
+#include <utility>
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <fmt/format.h>
+
+namespace sneze {
+
+frame_capture::frame_capture(): free_{max_buffers}, pending_{max_buffers} {}
+
+frame_capture::~frame_capture() {
+    stop();
+}
+
+void frame_capture::configure(const std::filesystem::path &folder, capture_format format) {
+    folder_ = folder;
+    format_ = format;
+}
+
+void frame_capture::request(std::size_t frames) {
+    if(!writer_.joinable()) {
+        writer_ = std::thread{&frame_capture::write_loop, this};
+    }
+    requested_ = frames;
+    remaining_ = frames;
+    sequence_++;
+    logger::info("capturing {} frames into: {}", frames, folder_.string());
+}
+
+void frame_capture::grab(SDL_Renderer *renderer) {
+    SNEZE_ZONE("frame_capture::grab");
+    // the position of the frame in the request, dropped or not
+    const auto position = requested_ - remaining_;
+    remaining_--;
+
+    auto buffer = free_.try_pop();
+    if(!buffer && buffers_ < max_buffers) {
+        buffer = std::make_unique<frame>();
+        buffers_++;
+    }
+    if(!buffer) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto &target = **buffer;
+    SDL_GetRendererOutputSize(renderer, &target.width, &target.height);
+    target.pixels.resize(static_cast<std::size_t>(target.width) * static_cast<std::size_t>(target.height) * 4);
+    // the logical size uses overscan, so the viewport covers the whole output
+    const auto rect = SDL_Rect{0, 0, target.width, target.height};
+    if(SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_RGBA32, target.pixels.data(), target.width * 4) != 0) {
+        logger::error("SDL_RenderReadPixels Error: {}", SDL_GetError());
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        static_cast<void>(free_.try_push(std::move(*buffer)));
+        return;
+    }
+
+    target.format = format_;
+    const auto *extension = format_ == capture_format::qoi ? "qoi" : "png";
+    target.path = folder_ / fmt::format("capture_{:03}_{:04}.{}", sequence_, position, extension);
+
+    // there are never more buffers than room in the queue
+    static_cast<void>(pending_.try_push(std::move(*buffer)));
+    ready_.release();
+}
+
+void frame_capture::stop() {
+    if(!writer_.joinable()) {
+        return;
+    }
+    remaining_ = 0;
+    ready_.release();
+    writer_.join();
+    logger::info("frame capture stopped, captured: {}, dropped: {}", captured(), dropped());
+}
+
+void frame_capture::write_loop() {
+    while(true) {
+        ready_.acquire();
+        // the frames are pending before the release to stop, so nothing pending means stop
+        auto pending = pending_.try_pop();
+        if(!pending) {
+            return;
+        }
+
+        if(auto err = write(**pending).ko(); err) {
+            logger::error("error writing captured frame: {}", (*pending)->path.string());
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            captured_.fetch_add(1, std::memory_order_relaxed);
+        }
+        static_cast<void>(free_.try_push(std::move(*pending)));
+    }
+}
+
+auto frame_capture::write(const frame &frame) -> result<> {
+    SNEZE_ZONE("frame_capture::write");
+    if(frame.format == capture_format::qoi) {
+        return write_qoi(frame);
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    auto *pixels = const_cast<std::uint8_t *>(frame.pixels.data());
+    auto *surface =
+        SDL_CreateRGBSurfaceWithFormatFrom(pixels, frame.width, frame.height, 32, frame.width * 4, SDL_PIXELFORMAT_RGBA32);
+    if(surface == nullptr) {
+        logger::error("SDL_CreateRGBSurfaceWithFormatFrom Error: {}", SDL_GetError());
+        return error("Can't encode captured frame.");
+    }
+
+    const auto saved = IMG_SavePNG(surface, frame.path.string().c_str());
+    SDL_FreeSurface(surface);
+    if(saved != 0) {
+        logger::error("IMG_SavePNG Error: {}", IMG_GetError());
+        return error("Can't write captured frame.");
+    }
+
+    return true;
+}
+
+namespace {
+//! QOI chunk of an index into the seen pixels
+constexpr auto qoi_op_index = std::uint8_t{0x00};
+//! QOI chunk of a small difference with the previous pixel
+constexpr auto qoi_op_diff = std::uint8_t{0x40};
+//! QOI chunk of a difference with the previous pixel, relative to green
+constexpr auto qoi_op_luma = std::uint8_t{0x80};
+//! QOI chunk of a run of the previous pixel
+constexpr auto qoi_op_run = std::uint8_t{0xc0};
+//! QOI chunk of a RGB pixel
+constexpr auto qoi_op_rgb = std::uint8_t{0xfe};
+//! QOI chunk of a RGBA pixel
+constexpr auto qoi_op_rgba = std::uint8_t{0xff};
+//! maximum length of a QOI run
+constexpr auto qoi_max_run = 62;
+
+//! a RGBA pixel
+struct pixel {
+    //! red
+    std::uint8_t r = 0; // NOLINT(readability-identifier-length)
+    //! green
+    std::uint8_t g = 0; // NOLINT(readability-identifier-length)
+    //! blue
+    std::uint8_t b = 0; // NOLINT(readability-identifier-length)
+    //! alpha
+    std::uint8_t a = 0; // NOLINT(readability-identifier-length)
+
+    auto operator==(const pixel &other) const -> bool = default;
+
+    //! the position of the pixel in the QOI index of seen pixels
+    [[nodiscard]] auto hash() const -> std::size_t {
+        return (r * 3U + g * 5U + b * 7U + a * 11U) % 64U;
+    }
+};
+
+//! write a 32 bits number in big endian
+void write_big_endian(std::vector<std::uint8_t> &bytes, std::uint32_t value) {
+    bytes.push_back(static_cast<std::uint8_t>(value >> 24U));
+    bytes.push_back(static_cast<std::uint8_t>(value >> 16U));
+    bytes.push_back(static_cast<std::uint8_t>(value >> 8U));
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+} // namespace
+
+auto frame_capture::write_qoi(const frame &frame) -> result<> {
+    auto bytes = std::vector<std::uint8_t>{'q', 'o', 'i', 'f'};
+    bytes.reserve(frame.pixels.size() / 2);
+    write_big_endian(bytes, static_cast<std::uint32_t>(frame.width));
+    write_big_endian(bytes, static_cast<std::uint32_t>(frame.height));
+    bytes.push_back(4); // channels
+    bytes.push_back(0); // sRGB with linear alpha
+
+    auto seen = std::array<pixel, 64>{};
+    auto previous = pixel{0, 0, 0, 255};
+    auto run = 0;
+    const auto count = frame.pixels.size() / 4;
+    for(std::size_t index = 0; index < count; ++index) {
+        const auto *data = &frame.pixels[index * 4];
+        const auto current = pixel{data[0], data[1], data[2], data[3]};
+
+        if(current == previous) {
+            run++;
+            if(run == qoi_max_run || index == count - 1) {
+                bytes.push_back(static_cast<std::uint8_t>(qoi_op_run | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+
+        if(run > 0) {
+            bytes.push_back(static_cast<std::uint8_t>(qoi_op_run | (run - 1)));
+            run = 0;
+        }
+
+        if(auto &slot = seen.at(current.hash()); slot == current) {
+            bytes.push_back(static_cast<std::uint8_t>(qoi_op_index | current.hash()));
+        } else {
+            slot = current;
+            if(current.a == previous.a) {
+                const auto red = static_cast<std::int8_t>(current.r - previous.r);
+                const auto green = static_cast<std::int8_t>(current.g - previous.g);
+                const auto blue = static_cast<std::int8_t>(current.b - previous.b);
+                const auto red_green = red - green;
+                const auto blue_green = blue - green;
+
+                if(red > -3 && red < 2 && green > -3 && green < 2 && blue > -3 && blue < 2) {
+                    bytes.push_back(
+                        static_cast<std::uint8_t>(qoi_op_diff | (red + 2) << 4 | (green + 2) << 2 | (blue + 2)));
+                } else if(red_green > -9 && red_green < 8 && green > -33 && green < 32 && blue_green > -9
+                          && blue_green < 8) {
+                    bytes.push_back(static_cast<std::uint8_t>(qoi_op_luma | (green + 32)));
+                    bytes.push_back(static_cast<std::uint8_t>((red_green + 8) << 4 | (blue_green + 8)));
+                } else {
+                    bytes.insert(bytes.end(), {qoi_op_rgb, current.r, current.g, current.b});
+                }
+            } else {
+                bytes.insert(bytes.end(), {qoi_op_rgba, current.r, current.g, current.b, current.a});
+            }
+        }
+        previous = current;
+    }
+    bytes.insert(bytes.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+
+    std::ofstream file{frame.path, std::ios::binary};
+    if(file.fail()) {
+        logger::error("failed to open file: {}", frame.path.string());
+        return error("Can't write captured frame.");
+    }
+    file.write(reinterpret_cast<const char *>(bytes.data()), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+               static_cast<std::streamsize>(bytes.size()));
+    file.close();
+    if(file.fail()) {
+        logger::error("failed to write file: {}", frame.path.string());
+        return error("Can't write captured frame.");
+    }
+
+    return true;
+}
+
+} // namespace sneze
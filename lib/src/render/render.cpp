@@ -32,12 +32,22 @@ SOFTWARE.
 #include "sneze/embedded/sneze_logo_data.hpp"
 #include "sneze/platform/logger.hpp"
 #include "sneze/platform/span_istream.hpp"
+#include "sneze/platform/startup.hpp"
+#include "sneze/platform/trace.hpp"
 #include "sneze/render/font.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <thread>
+#include <unordered_set>
 
 #include <SDL.h>
 #include <SDL_image.h>
+#include <fmt/format.h>
 
 namespace sneze {
 
@@ -47,17 +57,32 @@ auto render::init(const components::size &window,
                   const int &monitor,
                   const std::string &title,
                   const std::string &icon,
-                  const components::color &color) -> result<> {
+                  const components::color &color,
+                  const device::subsystems &subsystems,
+                  render_driver &driver) -> result<> {
+    SNEZE_ZONE("render::init");
     init_embedded_data();
+    startup::mark("embedded data");
 
     fullscreen_ = fullscreen;
+    logical_ = logical;
 
     logger::trace("init SDL");
-    if(SDL_Init(SDL_INIT_EVERYTHING) != 0) {
+    if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
         logger::error("SDL_Init Error: {}", SDL_GetError());
         return error("Error initializing rendering engine.");
     }
 
+    if(auto err = require_subsystems(subsystems).ko(); err) {
+        logger::error("error initializing the configured subsystems");
+        SDL_Quit();
+        return error("Error initializing rendering engine.", *err);
+    }
+    startup::mark("SDL init");
+
+    const auto driver_id = choose_driver(driver, monitor);
+    startup::mark("render driver");
+
     auto flags = SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE;
 
 #if not defined(__linux__)
@@ -91,15 +116,21 @@ auto render::init(const components::size &window,
         SDL_MaximizeWindow(window_);
     }
 #endif
+    startup::mark("window");
 
     logger::trace("creating SDL renderer");
-    renderer_ = SDL_CreateRenderer(window_, preferred_driver(), SDL_RENDERER_ACCELERATED);
+    renderer_ = SDL_CreateRenderer(window_, driver_id, SDL_RENDERER_ACCELERATED);
+    if(const auto software = find_driver("software"); renderer_ == nullptr && software) {
+        logger::warning("SDL_CreateRenderer Error: {}, falling back to the software driver", SDL_GetError());
+        renderer_ = SDL_CreateRenderer(window_, *software, SDL_RENDERER_SOFTWARE);
+    }
     if(renderer_ == nullptr) {
         SDL_DestroyWindow(window_);
         window_ = nullptr;
         logger::error("SDL_CreateRenderer Error: {}", SDL_GetError());
         return error("Error creating device render.");
     }
+    startup::mark("renderer");
 
     SDL_RenderSetLogicalSize(renderer_, static_cast<int>(logical.width), static_cast<int>(logical.height));
     SDL_SetHint(SDL_HINT_RENDER_LOGICAL_SIZE_MODE, "overscan");
@@ -133,9 +164,33 @@ auto render::init(const components::size &window,
     return true;
 }
 
+auto render::require_subsystems(const device::subsystems &subsystems) -> result<> {
+    const auto missing = subsystems & ~SDL_WasInit(0);
+    if(missing == device::subsystem::none) {
+        return true;
+    }
+
+    logger::debug("init SDL subsystems: {}", device::subsystem::string(missing));
+    if(SDL_InitSubSystem(missing) != 0) {
+        logger::error("SDL_InitSubSystem Error: {}", SDL_GetError());
+        return error("Error initializing subsystems.");
+    }
+
+    return true;
+}
+
 void render::end() {
     logger::trace("ending SDL renderer");
+    capture_.stop();
+    if(scene_ != nullptr) {
+        SDL_DestroyTexture(scene_);
+        scene_ = nullptr;
+    }
+    logger::debug("render stats on the last frames, {}", stats_.string());
+    sprite_sheets_.clear();
     fonts_.clear();
+    failed_embedded_.clear();
+    release_decoded_surfaces();
 
     if(renderer_ != nullptr) {
         SDL_DestroyRenderer(renderer_);
@@ -151,15 +206,226 @@ void render::end() {
 }
 
 void render::begin_frame() {
+    SNEZE_ZONE("render::begin_frame");
+    counters_ = {};
+    last_texture_ = nullptr;
+    if(scene_ != nullptr) {
+        // the window was resized or moved to a display with other pixel density, but it is not minimized
+        int output_width = 0;
+        int output_height = 0;
+        SDL_GetRendererOutputSize(renderer_, &output_width, &output_height);
+        const auto resized = output_width != scene_output_width_ || output_height != scene_output_height_;
+        if(resized && output_width > 0 && output_height > 0) [[unlikely]] {
+            if(auto err = create_scene().ko(); err) {
+                logger::error("error resizing the scene texture, dynamic resolution disabled");
+            }
+        }
+    }
+    if(scene_ != nullptr) {
+        SDL_SetRenderTarget(renderer_, scene_);
+        SDL_RenderSetScale(renderer_, scene_resolution_, scene_resolution_);
+        count_state_changes(2);
+    }
     SDL_SetRenderDrawColor(renderer_, clear_color_.r, clear_color_.g, clear_color_.b, clear_color_.a);
     SDL_RenderClear(renderer_);
+    count_state_changes(1);
+    count_draw(nullptr, 0);
 }
 
 void render::end_frame() {
-    SDL_RenderPresent(renderer_);
+    SNEZE_ZONE("render::end_frame");
+    if(scene_ != nullptr) {
+        const auto frame_time =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - presented_).count();
+
+        int width = 0;
+        int height = 0;
+        SDL_QueryTexture(scene_, nullptr, nullptr, &width, &height);
+        const auto src = SDL_Rect{0, 0, width, height};
+        const auto dst = SDL_FRect{0.F, 0.F, logical_.width, logical_.height};
+        SDL_SetRenderTarget(renderer_, nullptr);
+        SDL_RenderCopyF(renderer_, scene_, &src, &dst);
+        count_state_changes(1);
+        count_draw(scene_, 4);
+
+        if(capture_.wants_frame()) {
+            capture_.grab(renderer_);
+        }
+        SDL_RenderPresent(renderer_);
+        presented_ = std::chrono::steady_clock::now();
+        adjust_scene_scale(frame_time);
+    } else {
+        if(capture_.wants_frame()) {
+            capture_.grab(renderer_);
+        }
+        SDL_RenderPresent(renderer_);
+    }
+    update_stats();
+}
+
+void render::configure_capture(const std::filesystem::path &folder, capture_format format, std::size_t frames) {
+    capture_.configure(folder, format);
+    capture_frames_ = std::max(frames, std::size_t{1});
+}
+
+void render::capture(std::size_t frames) {
+    capture_.request(frames == 0 ? capture_frames_ : frames);
+}
+
+auto render::enable_dynamic_resolution(float target_fps, float min_scale) -> result<> {
+    if(SDL_RenderTargetSupported(renderer_) != SDL_TRUE) {
+        logger::error("the renderer can't render into textures");
+        return error("Can't enable dynamic resolution.");
+    }
+
+    target_frame_time_ = 1000.F / target_fps;
+    min_scene_scale_ = std::clamp(min_scale, 0.1F, 1.F);
+    scene_scale_ = 1.F;
+    if(auto err = create_scene().ko(); err) {
+        logger::error("error creating the scene texture");
+        return error("Can't enable dynamic resolution.", *err);
+    }
+    presented_ = std::chrono::steady_clock::now();
+
+    logger::debug("dynamic resolution enabled, target frame time: {:.2f} ms, minimum scale: {:.2f}",
+                  target_frame_time_,
+                  min_scene_scale_);
+    return true;
+}
+
+auto render::create_scene() -> result<> {
+    if(scene_ != nullptr) {
+        SDL_DestroyTexture(scene_);
+        scene_ = nullptr;
+    }
+
+    if(SDL_GetRendererOutputSize(renderer_, &scene_output_width_, &scene_output_height_) != 0) {
+        logger::error("SDL_GetRendererOutputSize Error: {}", SDL_GetError());
+        return error("Error creating scene texture.");
+    }
+
+    // the logical size uses overscan, it fills the output keeping its aspect ratio, so each logical unit has the same
+    // pixels on both axes, the largest of them
+    const auto pixels = std::max(static_cast<float>(scene_output_width_) / logical_.width,
+                                 static_cast<float>(scene_output_height_) / logical_.height);
+    scene_resolution_ = pixels * scene_scale_;
+
+    const auto width = std::max(1, static_cast<int>(logical_.width * scene_resolution_));
+    const auto height = std::max(1, static_cast<int>(logical_.height * scene_resolution_));
+    scene_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+    if(scene_ == nullptr) {
+        logger::error("SDL_CreateTexture Error: {}", SDL_GetError());
+        return error("Error creating scene texture.");
+    }
+
+    logger::debug("scene texture created: {}x{}, scale: {:.2f}", width, height, scene_scale_);
+    return true;
+}
+
+namespace {
+//! a frame is slow when it takes longer than this part of the target frame time
+constexpr auto slow_frame = 0.9F;
+//! a frame is fast when it takes less than this part of the target frame time
+constexpr auto fast_frame = 0.6F;
+//! consecutive slow frames before lowering the scale
+constexpr auto slow_frames_to_lower = 30;
+//! consecutive fast frames before raising the scale
+constexpr auto fast_frames_to_raise = 120;
+//! how much the scale changes each time
+constexpr auto scale_step = 0.1F;
+} // namespace
+
+void render::adjust_scene_scale(float frame_time) {
+    slow_frames_ = frame_time > target_frame_time_ * slow_frame ? slow_frames_ + 1 : 0;
+    fast_frames_ = frame_time < target_frame_time_ * fast_frame ? fast_frames_ + 1 : 0;
+
+    auto scale = scene_scale_;
+    if(slow_frames_ >= slow_frames_to_lower) {
+        scale = std::max(min_scene_scale_, scene_scale_ - scale_step);
+    } else if(fast_frames_ >= fast_frames_to_raise) {
+        scale = std::min(1.F, scene_scale_ + scale_step);
+    } else {
+        return;
+    }
+
+    slow_frames_ = 0;
+    fast_frames_ = 0;
+    if(std::abs(scale - scene_scale_) < std::numeric_limits<float>::epsilon()) {
+        return;
+    }
+
+    const auto previous = scene_scale_;
+    scene_scale_ = scale;
+    if(auto err = create_scene().ko(); err) {
+        logger::error("error resizing the scene texture, restoring the previous scale");
+        scene_scale_ = previous;
+        if(auto restore_err = create_scene().ko(); restore_err) {
+            logger::error("error restoring the scene texture, rendering at full resolution into the window");
+        }
+    }
+}
+
+void render::count_draw(const SDL_Texture *texture, std::uint32_t vertices) noexcept {
+    counters_.draw_calls++;
+    counters_.vertices += vertices;
+    if(texture != last_texture_) {
+        counters_.texture_switches++;
+        last_texture_ = texture;
+    }
+}
+
+namespace {
+
+/**
+ * @brief call a function with each counter of two render counters
+ * @tparam From the type of the counters to read
+ * @tparam To the type of the counters to write
+ * @tparam Function the type of the function
+ * @param from the counters to read
+ * @param to the counters to write
+ * @param function the function, called with the counter to read and the counter to write
+ */
+template<typename From, typename To, typename Function>
+void each_counter(const render_counters<From> &from, render_counters<To> &to, Function function) {
+    function(from.draw_calls, to.draw_calls);
+    function(from.vertices, to.vertices);
+    function(from.texture_switches, to.texture_switches);
+    function(from.state_changes, to.state_changes);
+    function(from.culled, to.culled);
+    function(from.labels, to.labels);
+    function(from.glyphs, to.glyphs);
+}
+
+} // namespace
+
+void render::update_stats() noexcept {
+    auto &oldest = counters_history_.at(counters_index_);
+    each_counter(oldest, counters_sum_, [](auto value, auto &sum) { sum -= value; });
+    each_counter(counters_, counters_sum_, [](auto value, auto &sum) { sum += value; });
+    oldest = counters_;
+    counters_index_ = (counters_index_ + 1) % stats_frames;
+    counters_frames_ = std::min(counters_frames_ + 1, stats_frames);
+
+    stats_.frame = counters_;
+    stats_.resolution_scale = scene_scale_;
+    const auto frames = static_cast<float>(counters_frames_);
+    each_counter(counters_sum_, stats_.average, [frames](auto sum, auto &average) {
+        average = static_cast<float>(sum) / frames;
+    });
 }
 
 [[nodiscard]] auto render::get_font(const std::string &font_path) -> std::shared_ptr<font> {
+    if(is_embedded_not_loaded(font_path, fonts_)) [[unlikely]] {
+        if(failed_embedded_.contains(font_path)) {
+            return nullptr;
+        }
+        logger::debug("loading embedded font on first use: ({})", font_path);
+        if(auto err = load_font(font_path).ko(); err) {
+            logger::error("fail to load embedded font: ({})", font_path);
+            failed_embedded_.insert(font_path);
+            return nullptr;
+        }
+    }
     if(auto [fnt, err] = fonts_.get(font_path).ok(); !err) {
         return *fnt; // NOLINT(bugprone-unchecked-optional-access)
     }
@@ -171,6 +437,7 @@ void render::draw_label(const components::label &label,
                         const components::position &from,
                         const components::color &color) {
     if(auto font = get_font(label.font); font != nullptr) [[likely]] {
+        counters_.labels++;
         font->draw_text(label.text, from, label.alignment, label.size, color);
     } else {
         logger::error("trying to draw a label with a not loaded font: ({})", label.font);
@@ -178,6 +445,7 @@ void render::draw_label(const components::label &label,
 }
 
 auto render::load_font(const std::string &font_path) -> result<> {
+    SNEZE_ZONE("render::load_font");
     logger::debug("loading font: ({})", font_path);
 
     if(auto err = fonts_.load(font_path).ko(); err) {
@@ -254,7 +522,168 @@ void render::toggle_fullscreen() {
                   real_logical.size.height);
 }
 
+auto render::preload(const manifest &assets, job_system &jobs, const progress_callback &progress) -> result<> {
+    SNEZE_ZONE("render::preload");
+    logger::debug("preloading {} assets", assets.size());
+
+    // find the textures needed by the assets that are not loaded, each of them is decoded only once
+    auto textures = std::vector<std::string>{};
+    auto unique_textures = std::unordered_set<std::string>{};
+    for(const auto &asset: assets) {
+        if(is_loaded(asset)) {
+            continue;
+        }
+        if(auto [dependencies, err] = get_dependencies(asset).ok(); !err) {
+            for(const auto &texture_path: *dependencies) { // NOLINT(bugprone-unchecked-optional-access)
+                if(!textures_.contains(texture_path) && unique_textures.insert(texture_path).second) {
+                    textures.push_back(texture_path);
+                }
+            }
+        } else {
+            logger::error("fail to get dependencies for asset: ({})", asset.path);
+            return error("Fail to preload assets", *err);
+        }
+    }
+
+    const auto total = textures.size() + assets.size();
+    auto done = std::size_t{0};
+
+    if(!textures.empty()) {
+        logger::debug("decoding {} textures using {} threads", textures.size(), jobs.size());
+
+        auto surfaces = std::vector<SDL_Surface *>(textures.size(), nullptr);
+        auto decoded = std::atomic<std::size_t>{0};
+        auto decoding = job_system::counter{};
+        for(std::size_t i = 0; i < textures.size(); ++i) {
+            jobs.run(decoding, [this, &textures, &surfaces, &decoded, i]() {
+                surfaces[i] = decode_surface(textures[i]);
+                decoded.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        // help decoding while reporting the progress in this thread
+        auto reported = std::size_t{0};
+        while(reported < textures.size()) {
+            if(!jobs.run_pending()) {
+                std::this_thread::yield();
+            }
+            for(const auto current = decoded.load(std::memory_order_acquire); reported < current; ++reported) {
+                if(progress) {
+                    progress(++done, total);
+                }
+            }
+        }
+        jobs.wait(decoding);
+
+        for(std::size_t i = 0; i < textures.size(); ++i) {
+            if(surfaces[i] != nullptr) {
+                decoded_surfaces_.emplace(textures[i], surfaces[i]);
+            }
+        }
+    }
+
+    for(auto it_asset = assets.begin(); it_asset != assets.end(); ++it_asset) {
+        if(auto err = load_asset(*it_asset).ko(); err) {
+            logger::error("fail to preload asset: ({})", it_asset->path);
+            // unload the assets loaded by this preload, so a failed preload does not need to be unloaded
+            unload(manifest{assets.begin(), it_asset});
+            release_decoded_surfaces();
+            return error("Fail to preload assets", *err);
+        }
+        if(progress) {
+            progress(++done, total);
+        }
+    }
+
+    release_decoded_surfaces();
+
+    return true;
+}
+
+void render::unload(const manifest &assets) {
+    for(const auto &asset: assets) {
+        switch(asset.type) {
+        case asset_type::font:
+            unload_font(asset.path);
+            break;
+        case asset_type::sprite:
+            unload_sprite(asset.path);
+            break;
+        case asset_type::sprite_sheet:
+            unload_sprite_sheet(asset.path);
+            break;
+        }
+    }
+}
+
+auto render::is_loaded(const asset &asset) const -> bool {
+    switch(asset.type) {
+    case asset_type::font:
+        return fonts_.contains(asset.path);
+    case asset_type::sprite:
+    case asset_type::sprite_sheet:
+        return sprite_sheets_.contains(asset.path);
+    }
+    return false;
+}
+
+auto render::get_dependencies(const asset &asset) -> result<std::vector<std::string>, error> {
+    switch(asset.type) {
+    case asset_type::font:
+        return font::dependencies(this, asset.path);
+    case asset_type::sprite:
+        return sprite_sheet::dependencies(this, asset.path, true);
+    case asset_type::sprite_sheet:
+        return sprite_sheet::dependencies(this, asset.path, false);
+    }
+    return error("Invalid asset type.");
+}
+
+auto render::load_asset(const asset &asset) -> result<> {
+    switch(asset.type) {
+    case asset_type::font:
+        return load_font(asset.path);
+    case asset_type::sprite:
+        return load_sprite(asset.path);
+    case asset_type::sprite_sheet:
+        return load_sprite_sheet(asset.path);
+    }
+    return error("Invalid asset type.");
+}
+
+auto render::decode_surface(const std::string &texture_path) -> SDL_Surface * {
+    SNEZE_ZONE("render::decode_surface");
+    if(auto *rwops = get_sdl_rwops(texture_path); rwops != nullptr) {
+        if(auto *surface = IMG_Load_RW(rwops, 1); surface != nullptr) {
+            logger::trace("texture decoded: ({})", texture_path);
+            return surface;
+        }
+        logger::error("error decoding texture: ({}) {}", texture_path, IMG_GetError());
+        return nullptr;
+    }
+    logger::error("error decoding texture: ({}) {}", texture_path, SDL_GetError());
+    return nullptr;
+}
+
+auto render::take_decoded_surface(const std::string &texture_path) -> SDL_Surface * {
+    if(auto it_surface = decoded_surfaces_.find(texture_path); it_surface != decoded_surfaces_.end()) {
+        auto *surface = it_surface->second;
+        decoded_surfaces_.erase(it_surface);
+        return surface;
+    }
+    return nullptr;
+}
+
+void render::release_decoded_surfaces() {
+    for(auto &[texture_path, surface]: decoded_surfaces_) {
+        logger::trace("releasing decoded texture not used: ({})", texture_path);
+        SDL_FreeSurface(surface);
+    }
+    decoded_surfaces_.clear();
+}
+
 auto render::load_texture(const std::string &texture_path) -> result<> {
+    SNEZE_ZONE("render::load_texture");
     logger::debug("loading texture: ({})", texture_path);
 
     if(auto err = textures_.load(texture_path).ko(); err) {
@@ -277,6 +706,7 @@ auto render::unload_texture(const std::string &texture_path) -> result<> {
 }
 
 auto render::load_sprite_sheet(const std::string &sprite_sheet_path) -> result<> {
+    SNEZE_ZONE("render::load_sprite_sheet");
     logger::debug("loading sprite sheet: ({})", sprite_sheet_path);
 
     if(auto err = sprite_sheets_.load(sprite_sheet_path, false).ko(); err) {
@@ -344,16 +774,10 @@ auto render::preferred_driver() -> int {
         "opengles"s,
     };
 
-    auto driver_info = SDL_RendererInfo{};
-
     for(const auto &driver_name: preferred_drivers) {
-        for(int driver_id = 0; driver_id < SDL_GetNumRenderDrivers(); ++driver_id) {
-            if(SDL_GetRenderDriverInfo(driver_id, &driver_info) == 0) {
-                if(driver_info.name == driver_name) {
-                    logger::debug("choosing preferred SDL driver: {}", driver_info.name);
-                    return driver_id;
-                }
-            }
+        if(auto driver_id = find_driver(driver_name); driver_id) {
+            logger::debug("choosing preferred SDL driver: {}", driver_name);
+            return *driver_id;
         }
     }
 
@@ -361,12 +785,154 @@ auto render::preferred_driver() -> int {
     return -1;
 }
 
+auto render::find_driver(const std::string &name) -> std::optional<int> {
+    auto driver_info = SDL_RendererInfo{};
+    for(int driver_id = 0; driver_id < SDL_GetNumRenderDrivers(); ++driver_id) {
+        if(SDL_GetRenderDriverInfo(driver_id, &driver_info) == 0 && driver_info.name == name) {
+            return driver_id;
+        }
+    }
+    return std::nullopt;
+}
+
+auto render::choose_driver(render_driver &driver, int monitor) -> int {
+    if(!driver.forced.empty()) {
+        if(auto driver_id = find_driver(driver.forced); driver_id) {
+            logger::info("choosing forced SDL driver: {}", driver.forced);
+            return *driver_id;
+        }
+        logger::warning("forced SDL driver not available: {}", driver.forced);
+    }
+
+    if(driver.probe) {
+        auto version = SDL_version{};
+        SDL_GetVersion(&version);
+        const auto sdl_version = fmt::format("{}.{}.{}", version.major, version.minor, version.patch);
+
+        auto mode = SDL_DisplayMode{};
+        const auto *display_name = SDL_GetDisplayName(monitor);
+        SDL_GetCurrentDisplayMode(monitor, &mode);
+        const auto display = fmt::format(
+            "{} {}x{}@{}", display_name != nullptr ? display_name : "unknown", mode.w, mode.h, mode.refresh_rate);
+
+        if(driver.sdl_version != sdl_version || driver.display != display || !find_driver(driver.probed)) {
+            logger::info("probing SDL drivers, SDL version: {}, display: {}", sdl_version, display);
+            driver.probed = probe_drivers();
+            driver.sdl_version = sdl_version;
+            driver.display = display;
+        }
+
+        if(auto driver_id = find_driver(driver.probed); driver_id) {
+            logger::info("choosing probed SDL driver: {}", driver.probed);
+            return *driver_id;
+        }
+    }
+
+    return preferred_driver();
+}
+
+auto render::probe_drivers() -> std::string {
+    SNEZE_ZONE("render::probe_drivers");
+    auto fastest = std::string{};
+    auto fastest_time = std::numeric_limits<float>::max();
+
+    auto driver_info = SDL_RendererInfo{};
+    for(int driver_id = 0; driver_id < SDL_GetNumRenderDrivers(); ++driver_id) {
+        if(SDL_GetRenderDriverInfo(driver_id, &driver_info) != 0) {
+            continue;
+        }
+        if(auto [time, err] = probe_driver(driver_id).ok(); !err) {
+            logger::info("SDL driver: {}, probe time: {:.2f} ms", driver_info.name, *time);
+            if(*time < fastest_time) {
+                fastest = driver_info.name;
+                fastest_time = *time;
+            }
+        } else {
+            logger::warning("SDL driver: {}, can't be probed", driver_info.name);
+        }
+    }
+
+    return fastest;
+}
+
+namespace {
+//! size of the hidden window and its target texture used to probe the drivers
+constexpr auto probe_size = 256;
+//! frames drawn on each driver probe
+constexpr auto probe_frames = 20;
+//! triangles and texture copies drawn on each frame of a driver probe
+constexpr auto probe_batch = 500;
+} // namespace
+
+auto render::probe_driver(int driver_id) -> result<float, error> {
+    auto *window = SDL_CreateWindow("probe", 0, 0, probe_size, probe_size, SDL_WINDOW_HIDDEN);
+    if(window == nullptr) {
+        logger::error("SDL_CreateWindow Error: {}", SDL_GetError());
+        return error("Error creating probe window.");
+    }
+
+    auto *renderer = SDL_CreateRenderer(window, driver_id, SDL_RENDERER_TARGETTEXTURE);
+    if(renderer == nullptr) {
+        logger::debug("SDL_CreateRenderer Error: {}", SDL_GetError());
+        SDL_DestroyWindow(window);
+        return error("Error creating probe renderer.");
+    }
+
+    auto *target =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, probe_size, probe_size);
+    auto *source = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, 16, 16);
+    if(target == nullptr || source == nullptr || SDL_SetRenderTarget(renderer, target) != 0) {
+        logger::debug("SDL render target Error: {}", SDL_GetError());
+        SDL_DestroyTexture(source);
+        SDL_DestroyTexture(target);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        return error("Error creating probe render target.");
+    }
+
+    auto vertexes = std::vector<SDL_Vertex>{};
+    auto copies = std::vector<SDL_Rect>{};
+    for(auto index = 0; index < probe_batch; ++index) {
+        const auto x = static_cast<float>((index * 37) % probe_size);
+        const auto y = static_cast<float>((index * 91) % probe_size);
+        const auto color = SDL_Color{static_cast<Uint8>(index), 128, 255, 128};
+        vertexes.push_back({{x, y}, color, {0, 0}});
+        vertexes.push_back({{x + 24.F, y}, color, {0, 0}});
+        vertexes.push_back({{x, y + 24.F}, color, {0, 0}});
+        copies.push_back({static_cast<int>(y), static_cast<int>(x), 16, 16});
+    }
+
+    auto pixel = Uint32{0};
+    const auto sync = SDL_Rect{0, 0, 1, 1};
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(auto frame = 0; frame < probe_frames; ++frame) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        SDL_RenderGeometry(renderer, nullptr, vertexes.data(), static_cast<int>(vertexes.size()), nullptr, 0);
+        for(const auto &copy: copies) {
+            SDL_RenderCopy(renderer, source, nullptr, &copy);
+        }
+        // reading a pixel waits for the driver to finish the frame
+        SDL_RenderReadPixels(renderer, &sync, SDL_PIXELFORMAT_RGBA32, &pixel, sizeof(pixel));
+    }
+    const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    SDL_DestroyTexture(source);
+    SDL_DestroyTexture(target);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+
+    return std::chrono::duration<float, std::milli>(elapsed).count() / static_cast<float>(probe_frames);
+}
+
 void render::draw_line(const components::line &line, const components::position &from, const components::color &color) {
     const components::size size{line.to.x - from.x, line.to.y - from.y};
     if(line.thickness == 1) {
         SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
         SDL_RenderDrawLineF(renderer_, from.x, from.y, from.x + size.width, from.y + size.height);
         SDL_SetRenderDrawColor(renderer_, clear_color_.r, clear_color_.g, clear_color_.b, clear_color_.a);
+        count_state_changes(2);
+        count_draw(nullptr, 2);
     } else {
         const float length = std::sqrt(size.width * size.width + size.height * size.height);
         const float scale = line.thickness / (2.F * length);
@@ -402,6 +968,7 @@ void render::fill_points_with_triangles(const std::vector<components::position>
     }
 
     SDL_RenderGeometry(renderer_, nullptr, vertexes.data(), static_cast<int>(vertexes.size()), nullptr, 0);
+    count_draw(nullptr, static_cast<std::uint32_t>(vertexes.size()));
 }
 
 void render::draw_box(const components::box &box, const components::position &from, const components::color &color) {
@@ -437,16 +1004,46 @@ void render::draw_border_box(const components::border_box &box,
     draw_box({box.to, box.thickness}, from, box.color);
 }
 
-void render::draw_sprite(components::sprite &sprite, const components::position &from, const components::color &color) {
+void render::draw_sprite(components::sprite &sprite,
+                         const components::position &from,
+                         const components::color &color,
+                         float scale,
+                         float rotation) {
     if(auto sprite_sheet = get_sprite_sheet(sprite.file); sprite_sheet != nullptr) [[likely]] {
-        return sprite_sheet->draw_sprite(
-            sprite.frame, from, sprite.flip_x, sprite.flip_y, sprite.rotation, sprite.scale, color);
+        return sprite_sheet->draw_sprite(sprite.frame,
+                                         from,
+                                         sprite.flip_x,
+                                         sprite.flip_y,
+                                         sprite.rotation + rotation,
+                                         sprite.scale * scale,
+                                         color);
     } else {
         logger::error("trying to draw a sprite with a not loaded sprite sheet: ({})", sprite.file);
     }
 }
 
+auto render::get_frame_index(const std::string &sprite_sheet_path, const std::string &frame)
+    -> result<std::size_t, error> {
+    if(auto sprite_sheet = get_sprite_sheet(sprite_sheet_path); sprite_sheet != nullptr) {
+        return sprite_sheet->frame_index(frame);
+    }
+    return error("Sprite sheet not loaded.");
+}
+
 auto render::get_sprite_sheet(const std::string &sprite_sheet_path) -> std::shared_ptr<sprite_sheet> {
+    if(is_embedded_not_loaded(sprite_sheet_path, sprite_sheets_)) [[unlikely]] {
+        if(failed_embedded_.contains(sprite_sheet_path)) {
+            return nullptr;
+        }
+        logger::debug("loading embedded sprite on first use: ({})", sprite_sheet_path);
+        const auto is_sprite_sheet = std::filesystem::path{sprite_sheet_path}.extension() == ".json";
+        if(auto err = (is_sprite_sheet ? load_sprite_sheet(sprite_sheet_path) : load_sprite(sprite_sheet_path)).ko();
+           err) {
+            logger::error("fail to load embedded sprite: ({})", sprite_sheet_path);
+            failed_embedded_.insert(sprite_sheet_path);
+            return nullptr;
+        }
+    }
     if(auto [sprite_sheet, err] = sprite_sheets_.get(sprite_sheet_path).ok(); !err) {
         return *sprite_sheet; // NOLINT(bugprone-unchecked-optional-access)
     }
@@ -24,9 +24,11 @@ SOFTWARE.
 
 #include "sneze/render/sprite_sheet.hpp"
 
+#include "sneze/platform/trace.hpp"
 #include "sneze/render/render.hpp"
 
 #include <fstream>
+#include <vector>
 
 #include <rapidjson/document.h>
 
@@ -55,13 +57,92 @@ auto parse_meta_data(const rapidjson::Document &document, const fs::path &base_d
     return full_texture_path.string();
 }
 
-auto parse_frames(const rapidjson::Document &document, std::unordered_map<std::string, frame> &frames_map) -> result<> {
+auto read_document(render *render,
+                   const fs::path &file_path,
+                   std::vector<char> &buffer,
+                   rapidjson::Document &document) -> result<> {
+    auto stream = render->get_istream(file_path.string());
+    if(stream == nullptr) {
+        logger::error("error opening sprite sheet file: {}", file_path.string());
+        return error("Can't open sprite sheet file.");
+    }
+
+    // read the whole file in one go, the buffer is parsed in-situ so strings are not copied by the parser
+    stream->seekg(0, std::ios::end);
+    const auto end_position = stream->tellg();
+    if(end_position < 0) {
+        logger::error("error getting size of sprite sheet file: {}", file_path.string());
+        return error("Can't read sprite sheet file.");
+    }
+    const auto stream_size = static_cast<std::size_t>(end_position);
+    stream->seekg(0, std::ios::beg);
+
+    buffer.assign(stream_size + 1, '\0');
+    stream->read(buffer.data(), static_cast<std::streamsize>(stream_size));
+    if(stream->bad()) {
+        logger::error("error reading sprite sheet file: {}", file_path.string());
+        return error("Can't read sprite sheet file.");
+    }
+    // text streams may read less than their size, due to line endings conversion
+    buffer.resize(static_cast<std::size_t>(stream->gcount()) + 1);
+    buffer.back() = '\0';
+
+    if(document.ParseInsitu(buffer.data()).HasParseError()) {
+        logger::error("error parsing json file: {}", file_path.string());
+        return error("Can't parse sprite sheet file.");
+    }
+
+    if(!document.IsObject()) {
+        logger::error("error parsing json file: {}", file_path.string());
+        return error("Can't parse sprite sheet file.");
+    }
+
+    return true;
+}
+
+auto parse_frame_source(const rapidjson::Value &frame_object, frame &frame) -> result<> {
+    frame.source_size = frame.rect.size;
+    frame.source_offset = {0, 0};
+    frame.rotated = false;
+
+    if(const auto it_rotated = frame_object.FindMember("rotated"); it_rotated != frame_object.MemberEnd()) {
+        frame.rotated = it_rotated->value.IsBool() && it_rotated->value.GetBool();
+    }
+
+    const auto it_trimmed = frame_object.FindMember("trimmed");
+    if(it_trimmed == frame_object.MemberEnd() || !it_trimmed->value.IsBool() || !it_trimmed->value.GetBool()) {
+        return true;
+    }
+
+    const auto it_source_rect = frame_object.FindMember("spriteSourceSize");
+    const auto it_source_size = frame_object.FindMember("sourceSize");
+    if(it_source_rect == frame_object.MemberEnd() || it_source_size == frame_object.MemberEnd() ||
+       !it_source_rect->value.IsObject() || !it_source_size->value.IsObject()) {
+        logger::error("error parsing sprite sheet, trimmed frame without source size");
+        return error("Can't parse sprite sheet file.");
+    }
+
+    const auto &source_rect = it_source_rect->value;
+    frame.source_offset = {source_rect["x"].GetFloat(), source_rect["y"].GetFloat()};
+
+    const auto &source_size = it_source_size->value;
+    frame.source_size = {source_size["w"].GetFloat(), source_size["h"].GetFloat()};
+
+    return true;
+}
+
+auto parse_frames(const rapidjson::Document &document,
+                  std::vector<frame> &frames_list,
+                  std::unordered_map<std::string, std::size_t> &frame_indexes) -> result<> {
     const auto &frames = document["frames"];
     if(!frames.IsArray()) {
         logger::error("error parsing sprite sheet, does not have frames");
         return error("Can't parse sprite sheet file.");
     }
 
+    frames_list.reserve(frames.Size());
+    frame_indexes.reserve(frames.Size());
+
     for(rapidjson::SizeType i = 0; i < frames.Size(); i++) {
         const auto &frame_object = frames[i];
         if(!frame_object.IsObject()) {
@@ -97,7 +178,17 @@ auto parse_frames(const rapidjson::Document &document, std::unordered_map<std::s
         const auto &pivot_y = pivot_data["y"].GetFloat();
         const auto pivot = components::position{pivot_x, pivot_y};
 
-        frames_map.emplace(frame_name, frame{rect, pivot});
+        auto new_frame = frame{rect, pivot};
+        if(auto err = parse_frame_source(frame_object, new_frame).ko(); err) {
+            logger::error("error parsing sprite sheet, invalid source for frame: {}", frame_name);
+            return error("Can't parse sprite sheet file.", *err);
+        }
+
+        if(frame_indexes.try_emplace(frame_name, frames_list.size()).second) {
+            frames_list.push_back(new_frame);
+        } else {
+            logger::warning("duplicated frame in sprite sheet: {}", frame_name);
+        }
     }
 
     return true;
@@ -120,26 +211,15 @@ auto sprite_sheet::init(const std::string &uri, bool is_single_texture) -> resul
 }
 
 auto sprite_sheet::init_from_json(const std::filesystem::path &file_path) -> result<> {
-
-    auto stream = get_render()->get_istream(file_path.string());
-    if(stream == nullptr) {
-        logger::error("error opening sprite sheet file: {}", file_path.string());
-        return error("Can't open sprite sheet file.");
-    }
-
+    SNEZE_ZONE("sprite_sheet::init_from_json");
+    auto buffer = std::vector<char>{};
     auto document = rapidjson::Document{};
-    const std::string json_string{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
-    if(document.Parse(json_string.c_str()).HasParseError()) {
-        logger::error("error parsing json file: {}", file_path.string());
-        return error("Can't parse sprite sheet file.");
+    if(auto err = read_document(get_render(), file_path, buffer, document).ko(); err) {
+        logger::error("error reading sprite sheet: {}", file_path.string());
+        return error("Can't load sprite sheet.", *err);
     }
 
-    if(!document.IsObject()) {
-        logger::error("error parsing json file: {}", file_path.string());
-        return error("Can't parse sprite sheet file.");
-    }
-
-    if(auto err = parse_frames(document, frames_).ko(); err) {
+    if(auto err = parse_frames(document, frames_, frame_indexes_).ko(); err) {
         logger::error("error parsing frames");
         return error("Can't parse sprite sheet file.", *err);
     }
@@ -159,13 +239,40 @@ auto sprite_sheet::init_from_json(const std::filesystem::path &file_path) -> res
 
     logger::trace("sprite sheet init success");
 
-    for(const auto &[name, frame]: frames_) {
+    for(const auto &[name, index]: frame_indexes_) {
+        const auto &frame = frames_.at(index);
         logger::trace("  frame: {} size: {}x{}", name, frame.rect.size.width, frame.rect.size.height);
     }
 
     return true;
 }
 
+auto sprite_sheet::dependencies(class render *render, const std::string &uri, bool is_single_texture)
+    -> result<std::vector<std::string>, error> {
+    if(!render->file_exists(uri)) {
+        logger::error("error sprite sheet does not exist: {}", uri);
+        return error("Error sprite sheet not exist.");
+    }
+
+    if(is_single_texture) {
+        return std::vector<std::string>{uri};
+    }
+
+    auto buffer = std::vector<char>{};
+    auto document = rapidjson::Document{};
+    if(auto err = read_document(render, uri, buffer, document).ko(); err) {
+        logger::error("error reading sprite sheet: {}", uri);
+        return error("Can't get sprite sheet dependencies.", *err);
+    }
+
+    if(auto [texture_name, err] = parse_meta_data(document, render->get_parent(uri)).ok(); !err) {
+        return std::vector<std::string>{*texture_name};
+    } else { // NOLINT(readability-else-after-return)
+        logger::error("error parsing meta data");
+        return error("Can't parse sprite sheet file.", *err);
+    }
+}
+
 auto sprite_sheet::init_from_texture(const std::filesystem::path &file_path) -> result<> {
     texture_ = file_path.string();
     if(auto err = get_render()->load_texture(texture_).ko(); err) {
@@ -181,7 +288,9 @@ auto sprite_sheet::init_from_texture(const std::filesystem::path &file_path) ->
     new_frame.rect.position = {0, 0};
     new_frame.rect.size = texture->size();
     new_frame.pivot = {0.5F, 0.5F};
-    frames_.emplace("default", new_frame);
+    new_frame.source_size = new_frame.rect.size;
+    frame_indexes_.emplace("default", frames_.size());
+    frames_.push_back(new_frame);
 
     logger::trace("sprite sheet init success");
 
@@ -195,10 +304,19 @@ auto sprite_sheet::end() -> void {
         texture_.clear();
     }
     frames_.clear();
+    frame_indexes_.clear();
 
     sprite_sheet_directory_.clear();
 }
 
+auto sprite_sheet::frame_index(const std::string &name) const -> result<std::size_t, error> {
+    if(auto it_index = frame_indexes_.find(name); it_index != frame_indexes_.end()) [[likely]] {
+        return it_index->second;
+    }
+    logger::error("frame not found in sprite sheet: {}", name);
+    return error("Frame not found.");
+}
+
 void sprite_sheet::draw_sprite(const std::string &name,
                                const components::position &position,
                                const bool &flip_x,
@@ -206,8 +324,22 @@ void sprite_sheet::draw_sprite(const std::string &name,
                                const float &rotation,
                                const float &scale,
                                const components::color &color) const {
-    if(auto it_frame = frames_.find(name); it_frame != frames_.end()) [[likely]] {
-        const auto &frame = it_frame->second;
+    if(auto it_index = frame_indexes_.find(name); it_index != frame_indexes_.end()) [[likely]] {
+        draw_sprite(it_index->second, position, flip_x, flip_y, rotation, scale, color);
+    } else {
+        logger::error("error drawing sprite, frame not found: {}", name);
+    }
+}
+
+void sprite_sheet::draw_sprite(const std::size_t &index,
+                               const components::position &position,
+                               const bool &flip_x,
+                               const bool &flip_y,
+                               const float &rotation,
+                               const float &scale,
+                               const components::color &color) const {
+    if(index < frames_.size()) [[likely]] {
+        const auto &frame = frames_[index];
 
         auto texture = get_render()->get_texture(texture_);
 
@@ -216,15 +348,50 @@ void sprite_sheet::draw_sprite(const std::string &name,
             return;
         }
 
-        auto pos_x = frame.rect.size.width * frame.pivot.x;
-        auto pos_y = frame.rect.size.height * frame.pivot.y;
+        using components::rect;
+
+        // the pivot is relative to the original sprite, not to the trimmed frame
+        const auto &source_size = frame.source_size;
+        const auto source_x = position.x - (source_size.width * frame.pivot.x * scale);
+        const auto source_y = position.y - (source_size.height * frame.pivot.y * scale);
+
+        // when flipping, the trimmed frame is mirrored inside the original sprite
+        const auto offset_x =
+            flip_x ? source_size.width - frame.source_offset.x - frame.rect.size.width : frame.source_offset.x;
+        const auto offset_y =
+            flip_y ? source_size.height - frame.source_offset.y - frame.rect.size.height : frame.source_offset.y;
 
-        auto dest = components::rect{{position.x - (pos_x * scale), position.y - (pos_y * scale)},
-                                     {frame.rect.size.width * scale, frame.rect.size.height * scale}};
+        const auto width = frame.rect.size.width * scale;
+        const auto height = frame.rect.size.height * scale;
+        const auto dest = rect{{source_x + (offset_x * scale), source_y + (offset_y * scale)}, {width, height}};
 
-        texture->draw(frame.rect, dest, flip_x, flip_y, rotation, color);
+        // sprites rotate around the center of the original sprite, as they did before trimming
+        const auto center = components::position{source_x + (source_size.width * scale / 2),
+                                                 source_y + (source_size.height * scale / 2)};
+
+        if(!frame.rotated) [[likely]] {
+            const auto dest_center = components::position{center.x - dest.position.x, center.y - dest.position.y};
+            texture->draw(frame.rect, dest, flip_x, flip_y, rotation, dest_center, color);
+            return;
+        }
+
+        // rotated frames are stored 90 degrees clockwise, we draw them -90 degrees into a destination that is the
+        // original destination rotated 90 degrees around the center, so both rotations share the same center,
+        // flips are swapped since they are applied before the rotation
+        const auto rotated_origin = rect{frame.rect.position, {frame.rect.size.height, frame.rect.size.width}};
+        const auto dest_mid_x = dest.position.x + (width / 2);
+        const auto dest_mid_y = dest.position.y + (height / 2);
+        const auto rotated_mid_x = center.x - (dest_mid_y - center.y);
+        const auto rotated_mid_y = center.y + (dest_mid_x - center.x);
+        const auto rotated_dest = rect{{rotated_mid_x - (height / 2), rotated_mid_y - (width / 2)}, {height, width}};
+        const auto rotated_center =
+            components::position{center.x - rotated_dest.position.x, center.y - rotated_dest.position.y};
+
+        constexpr auto stored_rotation = 90.0F;
+        texture->draw(
+            rotated_origin, rotated_dest, flip_y, flip_x, rotation - stored_rotation, rotated_center, color);
     } else {
-        logger::error("error drawing sprite, frame not found: {}", name);
+        logger::error("error drawing sprite, frame index out of range: {}", index);
     }
 }
 
@@ -24,6 +24,7 @@ SOFTWARE.
 
 #include "sneze/render/texture.hpp"
 
+#include "sneze/platform/trace.hpp"
 #include "sneze/render/render.hpp"
 
 #include <filesystem>
@@ -47,6 +48,7 @@ void texture::end() noexcept {
 }
 
 auto texture::init(const std::string &file) -> result<> {
+    SNEZE_ZONE("texture::init");
     if(auto [texture, err] = load_texture(file).ok(); err) {
         logger::error("load texture fail on file: ", file);
         return error{"Can't init texture.", *err};
@@ -58,6 +60,22 @@ auto texture::init(const std::string &file) -> result<> {
 }
 
 auto texture::load_texture(const std::string &file_path) -> result<SDL_Texture *const, error> {
+    if(auto *surface = get_render()->take_decoded_surface(file_path); surface != nullptr) {
+        auto *texture = SDL_CreateTextureFromSurface(get_render()->get_sdl_renderer(), surface);
+        SDL_FreeSurface(surface);
+        if(texture != nullptr) {
+            int width{0};
+            int height{0};
+            SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+            size_.height = static_cast<float>(height);
+            size_.width = static_cast<float>(width);
+            logger::trace("texture loaded from decoded surface: {}, size: {}x{}", file_path, width, height);
+            return texture;
+        }
+        logger::error("error creating texture: {}", SDL_GetError());
+        return error("Error loading texture.");
+    }
+
     if(auto *rwops = get_render()->get_sdl_rwops(file_path); rwops != nullptr) {
         if(auto *texture = IMG_LoadTexture_RW(get_render()->get_sdl_renderer(), rwops, 1); texture != nullptr) {
             int width{0};
@@ -88,6 +106,8 @@ void texture::draw(components::rect origin, components::rect destination, compon
         SDL_SetTextureColorMod(texture_, color.r, color.g, color.b);
         SDL_SetTextureAlphaMod(texture_, color.a);
         SDL_RenderCopy(get_render()->get_sdl_renderer(), texture_, &src, &dst);
+        get_render()->count_state_changes(2);
+        get_render()->count_draw(texture_, 4);
     }
 }
 
@@ -113,6 +133,35 @@ void texture::draw(components::rect origin,
                                                       | static_cast<int>(flip_x) * SDL_FLIP_HORIZONTAL);
 
         SDL_RenderCopyEx(get_render()->get_sdl_renderer(), texture_, &src, &dst, rotation, nullptr, sdl_flip);
+        get_render()->count_state_changes(2);
+        get_render()->count_draw(texture_, 4);
+    }
+}
+
+void texture::draw(components::rect origin,
+                   components::rect destination,
+                   const bool &flip_x,
+                   const bool &flip_y,
+                   float rotation,
+                   components::position center,
+                   components::color color) {
+    if(texture_ != nullptr) [[likely]] {
+        const auto src = SDL_Rect{static_cast<int>(origin.position.x),
+                                  static_cast<int>(origin.position.y),
+                                  static_cast<int>(origin.size.width),
+                                  static_cast<int>(origin.size.height)};
+        const auto dst =
+            SDL_FRect{destination.position.x, destination.position.y, destination.size.width, destination.size.height};
+        const auto sdl_center = SDL_FPoint{center.x, center.y};
+        SDL_SetTextureColorMod(texture_, color.r, color.g, color.b);
+        SDL_SetTextureAlphaMod(texture_, color.a);
+
+        auto sdl_flip = static_cast<SDL_RendererFlip>(static_cast<int>(flip_y) * SDL_FLIP_VERTICAL
+                                                      | static_cast<int>(flip_x) * SDL_FLIP_HORIZONTAL);
+
+        SDL_RenderCopyExF(get_render()->get_sdl_renderer(), texture_, &src, &dst, rotation, &sdl_center, sdl_flip);
+        get_render()->count_state_changes(2);
+        get_render()->count_draw(texture_, 4);
     }
 }
 
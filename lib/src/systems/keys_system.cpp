@@ -37,6 +37,15 @@ void keys_system::init(world *world) {
     if(toggle_full_screen_.key != keyboard::key::unknown) {
         logger::trace("toggle full screen key: [{}]", toggle_full_screen_.string());
     }
+    if(toggle_profiler_overlay_.key != keyboard::key::unknown) {
+        logger::trace("toggle profiler overlay key: [{}]", toggle_profiler_overlay_.string());
+    }
+    if(dump_trace_.key != keyboard::key::unknown) {
+        logger::trace("dump trace key: [{}]", dump_trace_.string());
+    }
+    if(capture_.key != keyboard::key::unknown) {
+        logger::trace("capture key: [{}]", capture_.string());
+    }
     world->add_listener<events::key_up, &keys_system::key_up>(this);
 }
 
@@ -50,9 +59,19 @@ void keys_system::key_up(const events::key_up &event) {
         event.world->emmit<events::application_want_closing>();
     } else if(event == toggle_full_screen_) {
         event.world->emmit<events::toggle_fullscreen>();
+    } else if(event == toggle_profiler_overlay_) {
+        event.world->emmit<events::toggle_profiler_overlay>();
+    } else if(event == dump_trace_) {
+        event.world->emmit<events::dump_trace>();
+    } else if(event == capture_) {
+        event.world->emmit<events::capture>();
     }
 }
 
 void keys_system::update(world * /*world*/) {}
 
+auto keys_system::access() const -> system_access {
+    return system_access{};
+}
+
 } // namespace sneze
\ No newline at end of file
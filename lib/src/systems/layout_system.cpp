@@ -34,29 +34,50 @@ void layout_system::init(world *world) {
     logger::trace("init layout system");
     world->add_listener<events::window_resized, &layout_system::window_resized>(this);
 
-    world->add_listener_to_add_component<components::anchor, &layout_system::add_component_anchor>(this);
+    changes_ = world->observe_changes<components::anchor, components::position>();
 }
 
 void layout_system::end(world *world) {
     logger::trace("end layout system");
     world->remove_listeners(this);
 
-    world->remove_component_listeners<components::anchor>(this);
+    changes_.reset();
 }
 
-void layout_system::update(world * /*world*/) {}
-
-void layout_system::window_resized(const events::window_resized &event) {
-    logical_ = event.logical;
+void layout_system::update(world *world) {
     using anchor = components::anchor;
 
-    for(auto const &&[entity, anc]: event.world->get_entities<anchor>()) {
-        calculate_layout(event.world, entity, anc);
+    if(resized_) {
+        // all the anchored entities, this includes any change
+        resized_ = false;
+        for(auto const &&[entity, anc]: world->get_entities<anchor>()) {
+            calculate_layout(world, entity, anc);
+        }
+        changes_->clear();
+        return;
     }
+
+    if(changes_->empty()) {
+        return;
+    }
+
+    // calculate the layout may add positions, that are changes, so we take the changes first
+    pending_.assign(changes_->begin(), changes_->end());
+    for(auto entity: pending_) {
+        if(auto *anc = world->has_component<anchor>(entity)) {
+            calculate_layout(world, entity, *anc);
+        }
+    }
+    changes_->clear();
+}
+
+auto layout_system::access() const -> system_access {
+    return system_access{}.read<components::anchor>().write<components::position, components::layout>().on_main_thread();
 }
 
-void layout_system::add_component_anchor(events::add_component<components::anchor> const &event) {
-    calculate_layout(event.world, event.entity, event.component);
+void layout_system::window_resized(const events::window_resized &event) {
+    logical_ = event.logical;
+    resized_ = true;
 }
 
 void layout_system::calculate_layout(world *world, entt::entity entity, const components::anchor &anc) const {
@@ -100,8 +121,8 @@ void layout_system::calculate_layout(world *world, entt::entity entity, const co
         world->set_component<position>(entity, position{0, 0});
     }
 
-    if(auto *current = world->has_component<layout>(entity)) {
-        *current = lay;
+    if(world->has_component<layout>(entity)) {
+        world->patch<layout>(entity, [&lay](auto &current) { current = lay; });
     } else {
         world->set_component<layout>(entity, lay);
     }
@@ -0,0 +1,232 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/systems/profiler_overlay_system.hpp"
+
+#include "sneze/app/world.hpp"
+#include "sneze/components/geometry.hpp"
+#include "sneze/components/renderable.hpp"
+#include "sneze/components/ui.hpp"
+#include "sneze/embedded/embedded.hpp"
+#include "sneze/platform/logger.hpp"
+#include "sneze/render/render.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace sneze {
+
+namespace {
+//! depth of the overlay, in front of everything else
+constexpr auto overlay_depth = -1'000'000.F;
+//! top left corner of the overlay
+constexpr auto origin = components::position{10.F, 10.F};
+//! width of the overlay
+constexpr auto width = 900.F;
+//! space between the border of the overlay and its content
+constexpr auto padding = 10.F;
+//! size of the font
+constexpr auto font_size = 24.F;
+//! height of each line of text
+constexpr auto line_height = 26.F;
+//! height of the frames graph
+constexpr auto graph_height = 100.F;
+//! frame time at the top of the frames graph, in milliseconds
+constexpr auto graph_max_time = 100.F / 3.F;
+//! frame time budget at 60 FPS, in milliseconds
+constexpr auto budget_60_fps = 1000.F / 60.F;
+//! frame time budget at 30 FPS, in milliseconds
+constexpr auto budget_30_fps = 1000.F / 30.F;
+//! maximum characters of the name of a section
+constexpr auto name_length = std::size_t{40};
+} // namespace
+
+profiler_overlay_system::profiler_overlay_system(std::shared_ptr<render> render): render_{std::move(render)} {}
+
+void profiler_overlay_system::init(world *world) {
+    logger::trace("init profiler overlay system");
+    world->add_listener<events::toggle_profiler_overlay, &profiler_overlay_system::toggle>(this);
+}
+
+void profiler_overlay_system::end(world *world) {
+    logger::trace("end profiler overlay system");
+    world->remove_listeners(this);
+    hide(world);
+    if(font_loaded_) {
+        if(auto err = render_->unload_font(embedded::mono_font).ko(); err) {
+            logger::error("fail to unload the profiler overlay font");
+        }
+        font_loaded_ = false;
+    }
+}
+
+void profiler_overlay_system::update(world *world) {
+    if(!visible_) {
+        return;
+    }
+
+    const auto &profile = world->get_global<frame_profile>();
+    write_lines(profile, world->get_global<render_stats>());
+    update_labels(world);
+
+    const auto top = origin.y + padding + line_height * static_cast<float>(lines_.size());
+    update_graph(world, profile, top);
+
+    auto &box = world->get_component<components::solid_box>(background_);
+    box.to = {origin.x + width, top + graph_height + padding};
+}
+
+auto profiler_overlay_system::access() const -> system_access {
+    return system_access::exclusive();
+}
+
+void profiler_overlay_system::toggle(const events::toggle_profiler_overlay &event) {
+    if(visible_) {
+        hide(event.world);
+    } else {
+        show(event.world);
+    }
+}
+
+void profiler_overlay_system::show(world *world) {
+    if(!font_loaded_) {
+        if(auto err = render_->load_font(embedded::mono_font).ko(); err) {
+            logger::error("can't show the profiler overlay without its font");
+            return;
+        }
+        font_loaded_ = true;
+    }
+
+    background_ = world->add_entity(components::renderable{overlay_depth},
+                                    components::solid_box{origin},
+                                    components::color::black.alpha(0.75F),
+                                    origin);
+
+    const auto graph_top = components::position{origin.x + padding, origin.y};
+    bars_ = world->add_entities(frame_profiler::frames,
+                                components::renderable{overlay_depth - 1.F, false},
+                                components::line{graph_top, 1.F},
+                                components::color::green,
+                                graph_top);
+
+    visible_ = true;
+}
+
+void profiler_overlay_system::hide(world *world) {
+    if(!visible_) {
+        return;
+    }
+    world->remove_entity(background_);
+    world->remove_entities(labels_);
+    world->remove_entities(bars_);
+    background_ = entt::null;
+    labels_.clear();
+    bars_.clear();
+    visible_ = false;
+}
+
+void profiler_overlay_system::write_lines(const frame_profile &profile, const render_stats &stats) {
+    const auto &average = stats.average;
+    lines_.resize(4 + profile.sections.size());
+    lines_[0] = fmt::format("FPS: {:.1f}  frame: {:.2f} ms", profile.fps, profile.frame_time);
+    lines_[1] = fmt::format("draws: {:.1f}  vertices: {:.1f}  textures: {:.1f}  states: {:.1f}",
+                            average.draw_calls,
+                            average.vertices,
+                            average.texture_switches,
+                            average.state_changes);
+    lines_[2] = fmt::format("culled: {:.1f}  labels: {:.1f}  glyphs: {:.1f}  scale: {:.2f}",
+                            average.culled,
+                            average.labels,
+                            average.glyphs,
+                            stats.resolution_scale);
+    lines_[3] = fmt::format("{:<{}} {:>7} {:>7} {:>7} {:>7}", "ms", name_length, "last", "min", "avg", "p99");
+    for(std::size_t index = 0; index < profile.sections.size(); ++index) {
+        const auto &section = profile.sections[index];
+        const auto name = section.name.size() > name_length ? section.name.substr(section.name.size() - name_length)
+                                                            : section.name;
+        lines_[index + 4] = fmt::format("{:<{}} {:>7.2f} {:>7.2f} {:>7.2f} {:>7.2f}",
+                                        name,
+                                        name_length,
+                                        section.last,
+                                        section.min,
+                                        section.avg,
+                                        section.p99);
+    }
+}
+
+void profiler_overlay_system::update_labels(world *world) {
+    while(labels_.size() < lines_.size()) {
+        const auto position =
+            components::position{origin.x + padding, origin.y + padding + line_height * static_cast<float>(labels_.size())};
+        labels_.push_back(world->add_entity(components::renderable{overlay_depth - 1.F},
+                                            components::label{"", embedded::mono_font, font_size},
+                                            components::color::white,
+                                            position));
+    }
+
+    for(std::size_t index = 0; index < labels_.size(); ++index) {
+        auto &renderable = world->get_component<components::renderable>(labels_[index]);
+        renderable.visible = index < lines_.size();
+        if(renderable.visible) {
+            world->get_component<components::label>(labels_[index]).text = lines_[index];
+        }
+    }
+}
+
+void profiler_overlay_system::update_graph(world *world, const frame_profile &profile, float top) {
+    const auto bar_width = (width - padding * 2.F) / static_cast<float>(bars_.size());
+    const auto bottom = top + graph_height;
+    // the newest frame is on the right
+    const auto first = bars_.size() - std::min(bars_.size(), profile.frames.size());
+
+    for(std::size_t index = 0; index < bars_.size(); ++index) {
+        auto &renderable = world->get_component<components::renderable>(bars_[index]);
+        renderable.visible = index >= first;
+        if(!renderable.visible) {
+            continue;
+        }
+
+        const auto frame_time = profile.frames[index - first];
+        const auto height = std::clamp(frame_time / graph_max_time, 0.F, 1.F) * graph_height;
+        const auto x = origin.x + padding + bar_width * (static_cast<float>(index) + 0.5F);
+
+        world->get_component<components::position>(bars_[index]) = {x, bottom};
+        auto &line = world->get_component<components::line>(bars_[index]);
+        line.to = {x, bottom - std::max(height, 1.F)};
+        line.thickness = std::max(bar_width - 1.F, 1.F);
+
+        auto &color = world->get_component<components::color>(bars_[index]);
+        if(frame_time <= budget_60_fps) {
+            color = components::color::green;
+        } else if(frame_time <= budget_30_fps) {
+            color = components::color::yellow;
+        } else {
+            color = components::color::red;
+        }
+    }
+}
+
+} // namespace sneze
@@ -24,7 +24,9 @@ SOFTWARE.
 
 #include "sneze/systems/render_system.hpp"
 
+#include "sneze/components/hierarchy.hpp"
 #include "sneze/platform/logger.hpp"
+#include "sneze/platform/trace.hpp"
 #include "sneze/render/render.hpp"
 
 namespace sneze {
@@ -34,6 +36,7 @@ render_system::render_system(std::shared_ptr<render> render): render_{std::move(
 void render_system::init(world *world) {
     logger::trace("init render system");
     world->add_listener<events::toggle_fullscreen, &render_system::toggle_fullscreen>(this);
+    world->add_listener<events::capture, &render_system::capture>(this);
 }
 
 void render_system::end(world *world) {
@@ -46,11 +49,29 @@ void render_system::update(world *world) {
 
     render_->begin_frame();
 
+    draw(world);
+
+    render_->end_frame();
+    world->get_global<render_stats>() = render_->get_stats();
+
+    if(auto &latency = world->get_global<input_latency>(); latency.pending && latency.is_handled) {
+        const auto presented = world->now();
+        latency.handled = static_cast<float>(latency.handled_time - latency.event_time);
+        latency.presented = static_cast<float>(presented - latency.event_time);
+        latency.pending = false;
+        latency.is_handled = false;
+    }
+}
+
+void render_system::draw(world *world) {
+    SNEZE_ZONE("render_system::draw");
+
     using color = components::color;
     using renderable = components::renderable;
     using position = components::position;
     using label = components::label;
     using layout = components::layout;
+    using world_transform = components::world_transform;
 
     for(auto const [id, renderable, color, pos]: world->get_entities<const renderable, const color, const position>()) {
         if(renderable.visible) {
@@ -62,6 +83,15 @@ void render_system::update(world *world) {
                 draw_position = *lay;
             }
 
+            // hierarchy transform
+            auto scale = 1.0F;
+            auto rotation = 0.0F;
+            if(auto *transform = world->has_component<world_transform>(id)) {
+                draw_position = transform->position;
+                scale = transform->scale;
+                rotation = transform->rotation;
+            }
+
             if(auto *lbl = world->has_component<label>(id)) {
                 render_->draw_label(*lbl, draw_position, color);
             } else if(auto *line = world->has_component<components::line>(id)) {
@@ -73,16 +103,24 @@ void render_system::update(world *world) {
             } else if(auto *border_box = world->has_component<components::border_box>(id)) {
                 render_->draw_border_box(*border_box, draw_position, color);
             } else if(auto *sprite = world->has_component<components::sprite>(id)) {
-                render_->draw_sprite(*sprite, draw_position, color);
+                render_->draw_sprite(*sprite, draw_position, color, scale, rotation);
             }
+        } else {
+            render_->count_culled();
         }
     }
+}
 
-    render_->end_frame();
+auto render_system::access() const -> system_access {
+    return system_access::exclusive();
 }
 
 void render_system::toggle_fullscreen(const events::toggle_fullscreen & /*event*/) noexcept {
     render_->toggle_fullscreen();
 }
 
+void render_system::capture(const events::capture &event) {
+    render_->capture(event.frames);
+}
+
 } // namespace sneze
@@ -30,6 +30,7 @@ SOFTWARE.
 #include "sneze/render/render.hpp"
 
 #include <SDL_events.h>
+#include <SDL_timer.h>
 
 namespace sneze {
 
@@ -41,54 +42,142 @@ void sdl_events_system::end(world * /*world*/) {
     logger::trace("end event system");
 }
 
+template<typename EventType, typename... Args>
+void sdl_events_system::send(world *world, Args &&...args) {
+    if(immediate_) {
+        world->trigger<EventType>(std::forward<Args>(args)...);
+    } else {
+        world->emmit<EventType>(std::forward<Args>(args)...);
+    }
+}
+
 void sdl_events_system::update(world *world) {
     using modifier = keyboard::modifier;
     static const auto valid_modifiers = modifier::shift | modifier::control | modifier::alt | modifier::gui;
     auto event_data = SDL_Event{};
     while(SDL_PollEvent(&event_data) != SDL_FALSE) {
+        switch(event_data.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEBUTTONDOWN:
+            // keep the order of the input
+            flush_mouse_moved(world);
+            input_received(world, event_data.common.timestamp);
+            break;
+        case SDL_MOUSEMOTION:
+            input_received(world, event_data.common.timestamp);
+            break;
+        }
+
         switch(event_data.type) {
         case SDL_QUIT:
             world->emmit<events::application_want_closing>();
             break;
         case SDL_KEYDOWN:
-            world->emmit<events::key_down>(event_data.key.keysym.sym,
-                                           static_cast<keyboard::mod>(event_data.key.keysym.mod & valid_modifiers));
+            send<events::key_down>(world,
+                                   event_data.key.keysym.sym,
+                                   static_cast<keyboard::mod>(event_data.key.keysym.mod & valid_modifiers));
             break;
         case SDL_KEYUP:
-            world->emmit<events::key_up>(event_data.key.keysym.sym,
-                                         static_cast<keyboard::mod>(event_data.key.keysym.mod & valid_modifiers));
+            send<events::key_up>(world,
+                                 event_data.key.keysym.sym,
+                                 static_cast<keyboard::mod>(event_data.key.keysym.mod & valid_modifiers));
             break;
         case SDL_MOUSEMOTION:
-            world->emmit<events::mouse_moved>(static_cast<float>(event_data.motion.x),
-                                              static_cast<float>(event_data.motion.y));
+            mouse_moved(world,
+                        {static_cast<float>(event_data.motion.x), static_cast<float>(event_data.motion.y)},
+                        {static_cast<float>(event_data.motion.xrel), static_cast<float>(event_data.motion.yrel)});
             break;
         case SDL_MOUSEBUTTONUP:
-            world->emmit<events::mouse_button_up>(sdl_mouse_button_to_sneze(event_data.button.button),
-                                                  static_cast<float>(event_data.button.x),
-                                                  static_cast<float>(event_data.button.y));
+            send<events::mouse_button_up>(world,
+                                          sdl_mouse_button_to_sneze(event_data.button.button),
+                                          static_cast<float>(event_data.button.x),
+                                          static_cast<float>(event_data.button.y));
             break;
         case SDL_MOUSEBUTTONDOWN:
-            world->emmit<events::mouse_button_down>(sdl_mouse_button_to_sneze(event_data.button.button),
-                                                    static_cast<float>(event_data.button.x),
-                                                    static_cast<float>(event_data.button.y));
+            send<events::mouse_button_down>(world,
+                                            sdl_mouse_button_to_sneze(event_data.button.button),
+                                            static_cast<float>(event_data.button.x),
+                                            static_cast<float>(event_data.button.y));
             break;
         case SDL_WINDOWEVENT:
             switch(event_data.window.event) {
-            case SDL_WINDOWEVENT_DISPLAY_CHANGED: {
-                auto window = render_->get_window_size();
-                auto logical = render_->window_to_logical(window);
-                world->emmit<events::window_resized>(window, logical);
-            } break;
-            case SDL_WINDOWEVENT_SIZE_CHANGED: {
-                auto window = components::size{static_cast<float>(event_data.window.data1),
-                                               static_cast<float>(event_data.window.data2)};
-                auto logical = render_->window_to_logical(window);
-                world->emmit<events::window_resized>(window, logical);
-            } break;
+            case SDL_WINDOWEVENT_DISPLAY_CHANGED:
+                window_resized(world, render_->get_window_size());
+                break;
+            case SDL_WINDOWEVENT_SIZE_CHANGED:
+                window_resized(world,
+                               {static_cast<float>(event_data.window.data1),
+                                static_cast<float>(event_data.window.data2)});
+                break;
             }
             break;
         }
     }
+
+    flush_mouse_moved(world);
+    flush_window_resized(world);
+
+    if(immediate_) {
+        if(auto &latency = world->get_global<input_latency>(); latency.pending && !latency.is_handled) {
+            latency.is_handled = true;
+            latency.handled_time = world->now();
+        }
+    }
+}
+
+void sdl_events_system::input_received(world *world, std::uint32_t timestamp) {
+    if(auto &latency = world->get_global<input_latency>(); !latency.pending) {
+        // the age of the event using the SDL clock, to the world clock
+        const auto age = static_cast<double>(SDL_GetTicks() - timestamp);
+        latency.pending = true;
+        latency.is_handled = false;
+        latency.event_time = world->now() - age;
+    }
+}
+
+void sdl_events_system::mouse_moved(world *world,
+                                    const components::position &point,
+                                    const components::position &delta) {
+    if(!coalesce_) {
+        send<events::mouse_moved>(world, point, delta);
+        return;
+    }
+    if(mouse_moved_.has_value()) {
+        mouse_moved_->point = point;
+        mouse_moved_->delta.x += delta.x;
+        mouse_moved_->delta.y += delta.y;
+    } else {
+        mouse_moved_ = events::mouse_moved{{world}, point, delta};
+    }
+}
+
+void sdl_events_system::window_resized(world *world, const components::size &window) {
+    auto logical = render_->window_to_logical(window);
+    if(!coalesce_) {
+        world->emmit<events::window_resized>(window, logical);
+        return;
+    }
+    window_resized_ = events::window_resized{{world}, window, logical};
+}
+
+void sdl_events_system::flush_mouse_moved(world *world) {
+    if(mouse_moved_.has_value()) {
+        send<events::mouse_moved>(world, mouse_moved_->point, mouse_moved_->delta);
+        mouse_moved_.reset();
+    }
+}
+
+void sdl_events_system::flush_window_resized(world *world) {
+    if(window_resized_.has_value()) {
+        world->emmit<events::window_resized>(window_resized_->window, window_resized_->logical);
+        window_resized_.reset();
+    }
+}
+
+auto sdl_events_system::access() const -> system_access {
+    return system_access::exclusive();
 }
 
 auto sdl_events_system::sdl_mouse_button_to_sneze(uint8_t button) -> mouse::button {
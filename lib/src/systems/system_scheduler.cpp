@@ -0,0 +1,128 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/systems/system_scheduler.hpp"
+
+#include "sneze/platform/logger.hpp"
+#include "sneze/platform/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace sneze {
+
+void system_scheduler::build(const systems_vector &systems) {
+    logger::trace("building systems graph");
+
+    const auto count = systems.size();
+    nodes_.assign(count, node{{}, 0, false, 0.F, nullptr});
+    remaining_ = std::make_unique<std::atomic<std::size_t>[]>(count); // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    for(std::size_t index = 0; index < count; ++index) {
+        const auto &access = systems[index]->access();
+        nodes_[index].main_thread = access.is_main_thread() || access.is_exclusive();
+        nodes_[index].name = trace::intern(systems[index]->name());
+        for(std::size_t before = 0; before < index; ++before) {
+            if(systems[before]->access().conflicts(access)) {
+                nodes_[before].dependents.push_back(index);
+                nodes_[index].dependencies++;
+            }
+        }
+    }
+}
+
+void system_scheduler::update(world *world, const systems_vector &systems, job_system &jobs) {
+    const auto count = systems.size();
+    if(count == 0) {
+        return;
+    }
+
+    for(std::size_t index = 0; index < count; ++index) {
+        remaining_[index].store(nodes_[index].dependencies, std::memory_order_relaxed);
+    }
+    completed_.store(0, std::memory_order_relaxed);
+    main_ready_.clear();
+
+    for(std::size_t index = 0; index < count; ++index) {
+        if(nodes_[index].dependencies == 0) {
+            launch(world, systems, jobs, index);
+        }
+    }
+
+    while(completed_.load(std::memory_order_acquire) < count) {
+        if(auto index = take_main_ready(); index.has_value()) {
+            run(world, systems, *index);
+            complete(world, systems, jobs, *index);
+        } else if(!jobs.run_pending()) {
+            std::this_thread::yield();
+        }
+    }
+
+    jobs.wait(running_);
+}
+
+void system_scheduler::launch(world *world, const systems_vector &systems, job_system &jobs, std::size_t index) {
+    if(nodes_[index].main_thread) {
+        const auto lock = std::scoped_lock{main_ready_mutex_};
+        main_ready_.push_back(index);
+        return;
+    }
+
+    jobs.run(running_, [this, world, &systems, &jobs, index]() {
+        run(world, systems, index);
+        complete(world, systems, jobs, index);
+    });
+}
+
+void system_scheduler::run(world *world, const systems_vector &systems, std::size_t index) {
+    using clock = std::chrono::high_resolution_clock;
+    const auto start = clock::now();
+    SNEZE_ZONE(nodes_[index].name);
+    systems[index]->update(world);
+    nodes_[index].elapsed = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+}
+
+void system_scheduler::complete(world *world, const systems_vector &systems, job_system &jobs, std::size_t index) {
+    for(auto dependent: nodes_[index].dependents) {
+        if(remaining_[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            launch(world, systems, jobs, dependent);
+        }
+    }
+    completed_.fetch_add(1, std::memory_order_release);
+}
+
+auto system_scheduler::take_main_ready() -> std::optional<std::size_t> {
+    const auto lock = std::scoped_lock{main_ready_mutex_};
+    if(main_ready_.empty()) {
+        return std::nullopt;
+    }
+    // the lower index is the system with higher priority
+    auto it_index = std::min_element(main_ready_.begin(), main_ready_.end());
+    auto index = *it_index;
+    main_ready_.erase(it_index);
+    return index;
+}
+
+} // namespace sneze
@@ -0,0 +1,147 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include "sneze/systems/transform_system.hpp"
+
+#include "sneze/app/world.hpp"
+#include "sneze/components/ui.hpp"
+#include "sneze/platform/logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace sneze {
+
+void transform_system::init(world *world) {
+    logger::trace("init transform system");
+    changes_ = world->observe_changes<components::position,
+                                      components::layout,
+                                      components::transform,
+                                      components::parent,
+                                      components::children>();
+}
+
+void transform_system::end(world * /*world*/) {
+    logger::trace("end transform system");
+    changes_.reset();
+}
+
+void transform_system::update(world *world) {
+    if(changes_->empty()) {
+        return;
+    }
+
+    dirty_.assign(changes_->begin(), changes_->end());
+    changes_->clear();
+    std::sort(dirty_.begin(), dirty_.end());
+
+    // the entities that have changed and are in a hierarchy, skipping the ones that an ancestor will recalculate
+    pending_.clear();
+    for(auto entity: dirty_) {
+        if(!world->has_component<components::parent>(entity) && !world->has_component<components::children>(entity)) {
+            continue;
+        }
+        if(!has_dirty_ancestor(world, entity)) {
+            pending_.push_back(entity);
+        }
+    }
+
+    // breadth first, so each parent is calculated before its children
+    for(std::size_t index = 0; index < pending_.size(); ++index) {
+        auto entity = pending_[index];
+        if(!world->is_valid(entity)) {
+            continue;
+        }
+        calculate(world, entity);
+        if(auto *children = world->has_component<components::children>(entity)) {
+            pending_.insert(pending_.end(), children->entities.begin(), children->entities.end());
+        }
+    }
+}
+
+auto transform_system::access() const -> system_access {
+    return system_access{}
+        .read<components::position,
+              components::layout,
+              components::transform,
+              components::parent,
+              components::children>()
+        .write<components::world_transform>()
+        .on_main_thread();
+}
+
+auto transform_system::has_dirty_ancestor(world *world, entt::entity entity) const -> bool {
+    while(auto *parent = world->has_component<components::parent>(entity)) {
+        entity = parent->entity;
+        if(!world->is_valid(entity)) {
+            return false;
+        }
+        if(std::binary_search(dirty_.begin(), dirty_.end(), entity)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto transform_system::calculate(world *world, entt::entity entity) -> const components::world_transform & {
+    auto result = components::world_transform{};
+
+    if(auto *lay = world->has_component<components::layout>(entity)) {
+        result.position = *lay;
+    } else if(auto *pos = world->has_component<components::position>(entity)) {
+        result.position = *pos;
+    }
+    if(auto *local = world->has_component<components::transform>(entity)) {
+        result.scale = local->scale;
+        result.rotation = local->rotation;
+    }
+
+    if(auto *parent = world->has_component<components::parent>(entity);
+       parent != nullptr && world->is_valid(parent->entity)) {
+        const auto *from = world->has_component<components::world_transform>(parent->entity);
+        // copy, adding a world transform could move the parent one
+        const auto base = from != nullptr ? *from : calculate(world, parent->entity);
+
+        const auto radians = base.rotation * std::numbers::pi_v<float> / 180.0F;
+        const auto cos = std::cos(radians);
+        const auto sin = std::sin(radians);
+        const auto x = result.position.x * base.scale;
+        const auto y = result.position.y * base.scale;
+
+        result.position.x = base.position.x + (x * cos) - (y * sin);
+        result.position.y = base.position.y + (x * sin) + (y * cos);
+        result.scale *= base.scale;
+        result.rotation += base.rotation;
+    }
+
+    if(auto *current = world->has_component<components::world_transform>(entity)) {
+        *current = result;
+        return *current;
+    }
+    world->set_component<components::world_transform>(entity, result);
+    return world->get_component<components::world_transform>(entity);
+}
+
+} // namespace sneze
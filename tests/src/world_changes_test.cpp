@@ -0,0 +1,148 @@
+/****************************************************************************
+MIT License
+
+Copyright (c) 2023 Juan Medina
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <fmt/format.h>
+#include <sneze/sneze.hpp>
+
+namespace {
+
+//! a world that the test can update, like the application does
+class test_world: public sneze::world {
+public:
+    using world::end;
+    using world::init;
+    using world::priority;
+    using world::update;
+};
+
+//! a component that is patched from a listener
+struct score {
+    int value = 0; // cppcheck-suppress unusedStructMember
+};
+
+//! an event that patches the score on its listener
+struct bonus: public sneze::events::event {};
+
+//! the entities that a system has read as changed on each frame
+using frames = std::vector<std::vector<entt::entity>>;
+
+//! a system that reads the changes of the score on each frame
+class reader_system: public sneze::system {
+public:
+    explicit reader_system(frames *read): read_{read} {}
+
+    void init(sneze::world * /*world*/) override {}
+
+    void end(sneze::world * /*world*/) override {}
+
+    void update(sneze::world *world) override {
+        const auto &changed = world->changed<score>();
+        read_->emplace_back(changed.begin(), changed.end());
+    }
+
+private:
+    frames *read_;
+};
+
+//! a system that runs after the reader and patches the score on a given frame
+class writer_system: public sneze::system {
+public:
+    writer_system(entt::entity entity, std::size_t frame): entity_{entity}, frame_{frame} {}
+
+    void init(sneze::world * /*world*/) override {}
+
+    void end(sneze::world * /*world*/) override {}
+
+    void update(sneze::world *world) override {
+        if(frames_++ == frame_) {
+            world->patch<score>(entity_, [](auto &score) { score.value += 1; });
+        }
+    }
+
+private:
+    entt::entity entity_;
+    std::size_t frame_;
+    std::size_t frames_ = 0;
+};
+
+//! listen to the bonus event and patch the score
+struct bonus_listener {
+    entt::entity entity;
+
+    void on_bonus(const bonus &event) const {
+        event.world->patch<score>(entity, [](auto &score) { score.value += 10; });
+    }
+};
+
+auto expect(bool condition, const char *message) -> bool {
+    if(!condition) {
+        fmt::print(stderr, "failed: {}\n", message);
+    }
+    return condition;
+}
+
+auto contains(const std::vector<entt::entity> &entities, entt::entity entity) -> bool {
+    return std::find(entities.begin(), entities.end(), entity) != entities.end();
+}
+
+} // namespace
+
+auto main(int /*argc*/, char * /*argv*/[]) -> int {
+    auto world = test_world{};
+    world.init();
+
+    auto read = frames{};
+    const auto entity = world.add_entity(score{});
+    auto listener = bonus_listener{entity};
+    world.add_listener<bonus, &bonus_listener::on_bonus>(listener);
+    world.add_system_with_priority<test_world::priority::normal, reader_system>(&read);
+    world.add_system_with_priority<test_world::priority::low, writer_system>(entity, std::size_t{2});
+
+    // frame 0, the listener patches the score after the systems have run
+    world.emmit<bonus>();
+    world.update();
+    // frame 1, the reader sees the change of the listener
+    world.update();
+    // frame 2, the writer patches the score after the reader
+    world.update();
+    // frame 3, the reader sees the change of the writer
+    world.update();
+    // frame 4, nothing has changed
+    world.update();
+
+    world.end();
+
+    auto passed = expect(read.size() == 5, "the reader runs on every frame");
+    passed = passed && expect(read[0].empty(), "nothing has changed before the listener");
+    passed = passed && expect(contains(read[1], entity), "a patch from a listener is read on the next frame");
+    passed = passed && expect(read[2].empty(), "a change is read only once");
+    passed = passed && expect(contains(read[3], entity), "a patch after the reader is read on the next frame");
+    passed = passed && expect(read[4].empty(), "nothing has changed on the last frame");
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}